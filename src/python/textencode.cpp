@@ -0,0 +1,358 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <textencode/common.hpp>
+#include <textencode/map.hpp>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Python bindings. Inputs are read through the buffer protocol without
+// copying, and the GIL is released while converting.
+
+namespace {
+
+using textencode::Converter;
+using textencode::ConverterMap;
+using textencode::EncodingType;
+
+const std::unordered_map<std::string_view, EncodingType> type_map = {
+    {"bin", EncodingType::Binary},      {"binary", EncodingType::Binary},
+    {"base16", EncodingType::Base16},   {"hex", EncodingType::Base16},
+    {"base32", EncodingType::Base32},   {"nix32", EncodingType::Nix32},
+    {"base58", EncodingType::Base58},   {"base64", EncodingType::Base64},
+    {"ascii85", EncodingType::Ascii85}, {"z85", EncodingType::Z85},
+};
+
+// Releases a Py_buffer when going out of scope
+class Buffer {
+  public:
+    Buffer() = default;
+    Buffer(Buffer&& other) noexcept : view(other.view) {
+        other.view.obj = nullptr;
+    }
+    ~Buffer() {
+        if (view.obj)
+            PyBuffer_Release(&view);
+    }
+    Buffer(const Buffer&) = delete;
+    Buffer& operator=(const Buffer&) = delete;
+
+    bool get(PyObject* obj, int flags = PyBUF_SIMPLE) {
+        return PyObject_GetBuffer(obj, &view, flags) == 0;
+    }
+
+    std::string_view data() const {
+        return std::string_view(static_cast<const char*>(view.buf), view.len);
+    }
+    char* writable() const {
+        return static_cast<char*>(view.buf);
+    }
+
+  private:
+    Py_buffer view{};
+};
+
+bool parseType(const char* name, EncodingType& type) {
+    const auto it = type_map.find(name);
+    if (it == type_map.end()) {
+        PyErr_Format(PyExc_ValueError, "%s is not a valid encoding type",
+                     name);
+        return false;
+    }
+    type = it->second;
+    return true;
+}
+
+// Runs func with the GIL released, converting exceptions into Python ones
+template <typename Func>
+bool withoutGil(Func&& func) {
+    std::exception_ptr error;
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        func();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    Py_END_ALLOW_THREADS
+
+    if (!error)
+        return true;
+    try {
+        std::rethrow_exception(error);
+    } catch (const std::system_error& e) {
+        PyErr_SetString(PyExc_OSError, e.what());
+    } catch (const std::bad_alloc&) {
+        PyErr_NoMemory();
+    } catch (const std::exception& e) {
+        PyErr_SetString(PyExc_ValueError, e.what());
+    }
+    return false;
+}
+
+PyObject* toBytes(std::string_view data) {
+    return PyBytes_FromStringAndSize(data.data(), data.size());
+}
+
+std::string convert(std::string_view data, EncodingType from,
+                    EncodingType to) {
+    const auto decoder = textencode::acquire(textencode::from_binary, from);
+    const auto encoder = textencode::acquire(textencode::to_binary, to);
+    std::string ret = encoder->process(decoder->process(data));
+    ret += encoder->process(decoder->complete());
+    ret += encoder->complete();
+    return ret;
+}
+
+struct ConverterObject {
+    PyObject_HEAD
+    Converter* converter;
+    // Calls from threads sharing the object are serialized
+    std::mutex* mutex;
+};
+
+void converterDealloc(ConverterObject* self) {
+    PyTypeObject* type = Py_TYPE(self);
+    delete self->converter;
+    delete self->mutex;
+    type->tp_free(reinterpret_cast<PyObject*>(self));
+    Py_DECREF(type);
+}
+
+PyObject* converterNew(PyTypeObject*, PyObject*, PyObject*) {
+    PyErr_SetString(PyExc_TypeError,
+                    "Converters are made by encoder() and decoder()");
+    return nullptr;
+}
+
+PyObject* converterProcess(ConverterObject* self, PyObject* arg) {
+    Buffer data;
+    if (!data.get(arg))
+        return nullptr;
+    std::string ret;
+    if (!withoutGil([&]() {
+            std::lock_guard<std::mutex> lock(*self->mutex);
+            ret = self->converter->process(data.data());
+        }))
+        return nullptr;
+    return toBytes(ret);
+}
+
+PyObject* converterComplete(ConverterObject* self, PyObject*) {
+    std::string ret;
+    if (!withoutGil([&]() {
+            std::lock_guard<std::mutex> lock(*self->mutex);
+            ret = self->converter->complete();
+        }))
+        return nullptr;
+    return toBytes(ret);
+}
+
+PyMethodDef converter_methods[] = {
+    {"process", reinterpret_cast<PyCFunction>(converterProcess), METH_O,
+     "process(data) -> bytes\n\nConverts the next chunk of data."},
+    {"complete", reinterpret_cast<PyCFunction>(converterComplete),
+     METH_NOARGS,
+     "complete() -> bytes\n\nFlushes the end of the conversion."},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+PyType_Slot converter_slots[] = {
+    {Py_tp_dealloc, reinterpret_cast<void*>(converterDealloc)},
+    {Py_tp_new, reinterpret_cast<void*>(converterNew)},
+    {Py_tp_methods, converter_methods},
+    {Py_tp_doc,
+     const_cast<char*>("A streaming converter from encoder() or decoder()")},
+    {0, nullptr},
+};
+
+PyType_Spec converter_spec = {
+    "textencode.Converter", sizeof(ConverterObject), 0, Py_TPFLAGS_DEFAULT,
+    converter_slots,
+};
+
+PyTypeObject* converter_type = nullptr;
+
+PyObject* makeConverter(PyObject* args, const ConverterMap& map) {
+    const char* name;
+    EncodingType type;
+    if (!PyArg_ParseTuple(args, "s", &name) || !parseType(name, type))
+        return nullptr;
+
+    auto* self = PyObject_New(ConverterObject, converter_type);
+    if (!self)
+        return nullptr;
+    self->converter = map.at(type)().release();
+    self->mutex = new std::mutex;
+    return reinterpret_cast<PyObject*>(self);
+}
+
+PyObject* encoder(PyObject*, PyObject* args) {
+    return makeConverter(args, textencode::to_binary);
+}
+
+PyObject* decoder(PyObject*, PyObject* args) {
+    return makeConverter(args, textencode::from_binary);
+}
+
+PyObject* convertFunc(PyObject*, PyObject* args) {
+    PyObject* obj;
+    const char *from_name, *to_name;
+    EncodingType from, to;
+    if (!PyArg_ParseTuple(args, "Oss", &obj, &from_name, &to_name) ||
+        !parseType(from_name, from) || !parseType(to_name, to))
+        return nullptr;
+
+    Buffer data;
+    if (!data.get(obj))
+        return nullptr;
+    std::string ret;
+    if (!withoutGil([&]() { ret = convert(data.data(), from, to); }))
+        return nullptr;
+    return toBytes(ret);
+}
+
+PyObject* convertInto(PyObject*, PyObject* args) {
+    PyObject *obj, *out_obj;
+    const char *from_name, *to_name;
+    EncodingType from, to;
+    if (!PyArg_ParseTuple(args, "OssO", &obj, &from_name, &to_name,
+                          &out_obj) ||
+        !parseType(from_name, from) || !parseType(to_name, to))
+        return nullptr;
+
+    Buffer data, out;
+    if (!data.get(obj) || !out.get(out_obj, PyBUF_WRITABLE))
+        return nullptr;
+
+    size_t size = 0;
+    bool too_small = false;
+    const auto in_place = textencode::in_place_from_binary.find(from);
+    if (!withoutGil([&]() {
+            // Decoding to binary happens over the input when out is the
+            // input itself. Any other out is only written once the whole
+            // conversion has succeeded.
+            if (to == EncodingType::Binary &&
+                in_place != textencode::in_place_from_binary.end() &&
+                out.writable() == data.data().data() &&
+                out.data().size() >= data.data().size()) {
+                size = in_place->second(out.writable(), data.data().size());
+                return;
+            }
+            const std::string ret = convert(data.data(), from, to);
+            size = ret.size();
+            too_small = size > out.data().size();
+            if (!too_small)
+                std::memcpy(out.writable(), ret.data(), size);
+        }))
+        return nullptr;
+
+    if (too_small) {
+        PyErr_Format(PyExc_ValueError,
+                     "Output buffer too small, %zu bytes are needed", size);
+        return nullptr;
+    }
+    return PyLong_FromSize_t(size);
+}
+
+PyObject* convertBatch(PyObject*, PyObject* args) {
+    PyObject* items;
+    const char *from_name, *to_name;
+    EncodingType from, to;
+    if (!PyArg_ParseTuple(args, "Oss", &items, &from_name, &to_name) ||
+        !parseType(from_name, from) || !parseType(to_name, to))
+        return nullptr;
+
+    PyObject* seq = PySequence_Fast(items, "items must be a sequence");
+    if (!seq)
+        return nullptr;
+    const Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+    std::vector<Buffer> buffers(count);
+    for (Py_ssize_t i = 0; i < count; ++i) {
+        if (!buffers[i].get(PySequence_Fast_GET_ITEM(seq, i))) {
+            Py_DECREF(seq);
+            return nullptr;
+        }
+    }
+
+    // Every item is converted in one go without the GIL
+    std::vector<std::string> results(count);
+    const bool ok = withoutGil([&]() {
+        for (Py_ssize_t i = 0; i < count; ++i)
+            results[i] = convert(buffers[i].data(), from, to);
+    });
+    buffers.clear();
+    Py_DECREF(seq);
+    if (!ok)
+        return nullptr;
+
+    PyObject* ret = PyList_New(count);
+    if (!ret)
+        return nullptr;
+    for (Py_ssize_t i = 0; i < count; ++i) {
+        PyObject* item = toBytes(results[i]);
+        if (!item) {
+            Py_DECREF(ret);
+            return nullptr;
+        }
+        PyList_SET_ITEM(ret, i, item);
+    }
+    return ret;
+}
+
+PyMethodDef methods[] = {
+    {"encoder", encoder, METH_VARARGS,
+     "encoder(type) -> Converter\n\nA converter from binary to type."},
+    {"decoder", decoder, METH_VARARGS,
+     "decoder(type) -> Converter\n\nA converter from type to binary."},
+    {"convert", convertFunc, METH_VARARGS,
+     "convert(data, from_type, to_type) -> bytes"},
+    {"convert_into", convertInto, METH_VARARGS,
+     "convert_into(data, from_type, to_type, out) -> int\n\n"
+     "Writes the result into the writable buffer out, returning its size.\n"
+     "out is left unchanged on errors, unless it is the input itself, which\n"
+     "is then decoded in place."},
+    {"convert_batch", convertBatch, METH_VARARGS,
+     "convert_batch(items, from_type, to_type) -> list\n\n"
+     "Converts each item of a sequence independently."},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+PyModuleDef module = {
+    PyModuleDef_HEAD_INIT,
+    "textencode",
+    "Text encoding conversions",
+    -1,
+    methods,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+};
+
+}  // namespace
+
+PyMODINIT_FUNC PyInit_textencode() {
+    PyObject* ret = PyModule_Create(&module);
+    if (!ret)
+        return nullptr;
+    converter_type =
+        reinterpret_cast<PyTypeObject*>(PyType_FromSpec(&converter_spec));
+    if (!converter_type ||
+        PyModule_AddObject(ret, "Converter",
+                           reinterpret_cast<PyObject*>(converter_type)) < 0) {
+        Py_DECREF(ret);
+        return nullptr;
+    }
+    // The module's reference was stolen, keep one for PyObject_New
+    Py_INCREF(converter_type);
+    return ret;
+}
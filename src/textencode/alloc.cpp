@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <string_view>
+#include <textencode/alloc.hpp>
+#include <textencode/common.hpp>
+#include <utility>
+
+namespace textencode {
+
+namespace {
+
+// Constant initialized, so operator new can use it on any thread at any time
+struct Counters {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    int64_t live = 0;
+    int64_t peak = 0;
+};
+
+thread_local Counters counters;
+
+}  // namespace
+
+#ifdef TEXTENCODE_ALLOC_STATS
+
+namespace internal {
+
+// Each block starts with its size, so that freeing it can be counted. The
+// header is as long as the alignment, keeping what follows it aligned.
+constexpr size_t block_header = alignof(std::max_align_t);
+
+void* countedAlloc(size_t size, size_t alignment = block_header) noexcept {
+    const size_t header = std::max(alignment, block_header);
+    void* const block =
+        alignment <= block_header
+            ? std::malloc(size + header)
+            : std::aligned_alloc(alignment, (size + header + alignment - 1) /
+                                                alignment * alignment);
+    if (!block)
+        return nullptr;
+    *static_cast<size_t*>(block) = size;
+    counters.allocations += 1;
+    counters.bytes += size;
+    counters.live += size;
+    counters.peak = std::max(counters.peak, counters.live);
+    return static_cast<char*>(block) + header;
+}
+
+void countedFree(void* p, size_t alignment = block_header) noexcept {
+    if (!p)
+        return;
+    void* const block =
+        static_cast<char*>(p) - std::max(alignment, block_header);
+    counters.live -= *static_cast<size_t*>(block);
+    std::free(block);
+}
+
+}  // namespace internal
+
+bool allocStatsEnabled() {
+    return true;
+}
+
+#else
+
+bool allocStatsEnabled() {
+    return false;
+}
+
+#endif
+
+AllocScope::AllocScope()
+    : start{counters.allocations, counters.bytes, 0},
+      start_live(counters.live),
+      outer_peak(counters.peak) {
+    counters.peak = counters.live;
+}
+
+AllocScope::~AllocScope() {
+    counters.peak = std::max(outer_peak, counters.peak);
+}
+
+AllocStats AllocScope::stats() const {
+    AllocStats ret;
+    ret.allocations = counters.allocations - start.allocations;
+    ret.bytes = counters.bytes - start.bytes;
+    ret.peak_bytes = counters.peak - start_live;
+    return ret;
+}
+
+CountedConverter::CountedConverter(std::unique_ptr<Converter> converter)
+    : converter(std::move(converter)) {
+}
+
+std::string CountedConverter::process(std::string_view data) {
+    AllocScope scope;
+    std::string ret = converter->process(data);
+    add(scope.stats());
+    return ret;
+}
+
+std::pmr::string CountedConverter::process(
+    std::string_view data, std::pmr::memory_resource* resource) {
+    AllocScope scope;
+    std::pmr::string ret = converter->process(data, resource);
+    add(scope.stats());
+    return ret;
+}
+
+std::string CountedConverter::complete() {
+    AllocScope scope;
+    std::string ret = converter->complete();
+    add(scope.stats());
+    return ret;
+}
+
+std::pmr::string CountedConverter::complete(
+    std::pmr::memory_resource* resource) {
+    AllocScope scope;
+    std::pmr::string ret = converter->complete(resource);
+    add(scope.stats());
+    return ret;
+}
+
+std::string CountedConverter::snapshot() const {
+    return converter->snapshot();
+}
+
+void CountedConverter::restore(std::string_view state) {
+    AllocScope scope;
+    converter->restore(state);
+    add(scope.stats());
+}
+
+void CountedConverter::reset() {
+    converter->reset();
+}
+
+void CountedConverter::add(const AllocStats& call) {
+    counted.allocations += call.allocations;
+    counted.bytes += call.bytes;
+    counted.peak_bytes = std::max(counted.peak_bytes, call.peak_bytes);
+}
+
+}  // namespace textencode
+
+#ifdef TEXTENCODE_ALLOC_STATS
+
+// The replaceable allocation functions, which the rest of the standard
+// library's forms of operator new and delete end up calling
+void* operator new(std::size_t size) {
+    void* const p = textencode::internal::countedAlloc(size);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return textencode::internal::countedAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return textencode::internal::countedAlloc(size);
+}
+
+void operator delete(void* p) noexcept {
+    textencode::internal::countedFree(p);
+}
+
+void operator delete[](void* p) noexcept {
+    textencode::internal::countedFree(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    textencode::internal::countedFree(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    textencode::internal::countedFree(p);
+}
+
+// std::pmr::new_delete_resource() allocates through the aligned forms
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    void* const p = textencode::internal::countedAlloc(
+        size, static_cast<size_t>(alignment));
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return ::operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+    return textencode::internal::countedAlloc(size,
+                                              static_cast<size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+    return textencode::internal::countedAlloc(size,
+                                              static_cast<size_t>(alignment));
+}
+
+void operator delete(void* p, std::align_val_t alignment) noexcept {
+    textencode::internal::countedFree(p, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* p, std::align_val_t alignment) noexcept {
+    textencode::internal::countedFree(p, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* p, std::size_t,
+                     std::align_val_t alignment) noexcept {
+    textencode::internal::countedFree(p, static_cast<size_t>(alignment));
+}
+
+void operator delete[](void* p, std::size_t,
+                       std::align_val_t alignment) noexcept {
+    textencode::internal::countedFree(p, static_cast<size_t>(alignment));
+}
+
+#endif
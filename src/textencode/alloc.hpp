@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <textencode/common.hpp>
+
+namespace textencode {
+
+// Heap use through operator new on one thread. Only a library configured
+// with --enable-alloc-stats replaces operator new and delete to count it,
+// otherwise everything stays zero.
+struct AllocStats {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    // The most bytes live at once, above those live when counting started
+    uint64_t peak_bytes = 0;
+};
+
+// Whether this build of the library counts allocations
+bool allocStatsEnabled();
+
+// Counts the allocations made by the current thread while it exists, such
+// as those of a transcode() call it wraps. Scopes may nest, each seeing the
+// allocations of those inside it.
+class AllocScope {
+  public:
+    AllocScope();
+    ~AllocScope();
+
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+
+    AllocStats stats() const;
+
+  private:
+    AllocStats start;
+    // Blocks may be freed by another thread than the one allocating them,
+    // so live bytes can drop below zero
+    int64_t start_live;
+    int64_t outer_peak;
+};
+
+// Passes everything through to another converter, adding up the
+// allocations made by each call, so the heap use of one converter can be
+// told apart from that of its neighbours
+class CountedConverter : public Converter {
+  public:
+    explicit CountedConverter(std::unique_ptr<Converter> converter);
+
+    std::string process(std::string_view data) override;
+    std::pmr::string process(std::string_view data,
+                             std::pmr::memory_resource* resource) override;
+    std::string complete() override;
+    std::pmr::string complete(std::pmr::memory_resource* resource) override;
+    std::string snapshot() const override;
+    void restore(std::string_view state) override;
+    void reset() override;
+
+    // The peak is the highest reached by any one call
+    const AllocStats& stats() const {
+        return counted;
+    }
+
+  private:
+    std::unique_ptr<Converter> converter;
+    AllocStats counted;
+
+    void add(const AllocStats& call);
+};
+
+}  // namespace textencode
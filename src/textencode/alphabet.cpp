@@ -0,0 +1,313 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <textencode/alphabet.hpp>
+#include <textencode/internal/base_n.hpp>
+#include <textencode/internal/common.hpp>
+#include <textencode/internal/state.hpp>
+#include <textencode/internal/utils.hpp>
+
+namespace textencode {
+
+using internal::CharCodes;
+using internal::Common;
+
+namespace {
+
+template <EncodingType type>
+Alphabet standardAlphabet() {
+    constexpr auto& symbols = Common<type>::symbols;
+    return Alphabet(std::string_view(symbols.data(), symbols.size()));
+}
+
+// The encodeQuanta() and decodeQuanta() kernels driven by a run time alphabet
+void encodeQuanta(const Alphabet& alphabet, const char* in, size_t quanta,
+                  char* out) {
+    const size_t shift = alphabet.shift();
+    const size_t quantum_bytes = alphabet.quantumBits() / 8;
+    const size_t quantum_symbols = alphabet.quantumSymbols();
+    const size_t mask = (size_t(1) << shift) - 1;
+    const char* symbols = alphabet.symbols().data();
+
+    for (size_t q = 0; q < quanta; ++q) {
+        uint64_t buffer = 0;
+        for (size_t i = 0; i < quantum_bytes; ++i)
+            buffer = (buffer << 8) | (*in++ & 0xff);
+        for (size_t i = quantum_symbols; i > 0; --i)
+            *out++ = symbols[(buffer >> ((i - 1) * shift)) & mask];
+    }
+}
+
+size_t decodeQuanta(const Alphabet& alphabet, const char* in, size_t quanta,
+                    char* out) {
+    const size_t shift = alphabet.shift();
+    const size_t quantum_bytes = alphabet.quantumBits() / 8;
+    const size_t quantum_symbols = alphabet.quantumSymbols();
+    const auto& inverse = alphabet.inverse();
+
+    for (size_t q = 0; q < quanta; ++q) {
+        uint64_t buffer = 0;
+        char seen = 0;
+        for (size_t i = 0; i < quantum_symbols; ++i) {
+            const char byte = inverse[static_cast<unsigned char>(in[i])];
+            seen |= byte;
+            buffer = (buffer << shift) | (byte & 0x3f);
+        }
+        if (!alphabet.validByte(seen))
+            return q;
+        in += quantum_symbols;
+        for (size_t i = quantum_bytes; i > 0; --i)
+            *out++ = buffer >> ((i - 1) * 8);
+    }
+    return quanta;
+}
+
+}  // namespace
+
+Alphabet::Alphabet(std::string_view symbols) : size(symbols.size()) {
+    if (size < 2 || size > table.size() || (size & (size - 1)) != 0)
+        throw std::invalid_argument(
+            "An alphabet needs 2, 4, 8, 16, 32 or 64 symbols");
+
+    std::array<bool, 256> seen{};
+    for (const char symbol : symbols) {
+        if (symbol == ' ' || symbol == '\r' || symbol == '\n' || symbol == '=')
+            throw std::invalid_argument(
+                "Alphabet symbols can't be whitespace or '='");
+        if (seen[static_cast<unsigned char>(symbol)])
+            throw std::invalid_argument("Repeated alphabet symbol");
+        seen[static_cast<unsigned char>(symbol)] = true;
+    }
+
+    std::copy(symbols.begin(), symbols.end(), table.begin());
+    inverse_table = internal::makeInverse(symbols);
+    bits = internal::sizeToShift(size);
+    quantum_bits = internal::lcm(8, bits);
+}
+
+Alphabet Alphabet::standard(EncodingType type) {
+    switch (type) {
+        case EncodingType::Base16:
+            return standardAlphabet<EncodingType::Base16>();
+        case EncodingType::Base32:
+            return standardAlphabet<EncodingType::Base32>();
+        case EncodingType::Base64:
+            return standardAlphabet<EncodingType::Base64>();
+        default:
+            throw std::invalid_argument("Not a base-n encoding");
+    }
+}
+
+ToCustomBaseN::ToCustomBaseN(const Alphabet& alphabet) : alphabet(alphabet) {
+}
+
+std::string ToCustomBaseN::process(std::string_view data) {
+    return processAs(data, std::string());
+}
+
+std::pmr::string ToCustomBaseN::process(std::string_view data,
+                                        std::pmr::memory_resource* resource) {
+    return processAs(data, std::pmr::string(resource));
+}
+
+std::string ToCustomBaseN::complete() {
+    return completeAs(std::string());
+}
+
+std::pmr::string ToCustomBaseN::complete(std::pmr::memory_resource* resource) {
+    return completeAs(std::pmr::string(resource));
+}
+
+template <typename String>
+String ToCustomBaseN::processAs(std::string_view data, String ret) {
+    const size_t quantum_bytes = alphabet.quantumBits() / 8;
+    ret.resize((num_bits / 8 + data.size()) / quantum_bytes *
+               alphabet.quantumSymbols());
+    char* out = ret.data();
+
+    // Top up the partial quantum left by the last call
+    for (; num_bits > 0 && !data.empty(); data.remove_prefix(1)) {
+        buffer = (buffer << 8) | (data[0] & 0xff);
+        num_bits += 8;
+        if (num_bits == alphabet.quantumBits())
+            out = flushBuffer(out);
+    }
+
+    const size_t quanta = data.size() / quantum_bytes;
+    encodeQuanta(alphabet, data.data(), quanta, out);
+    out += quanta * alphabet.quantumSymbols();
+
+    for (const char byte : data.substr(quanta * quantum_bytes)) {
+        buffer = (buffer << 8) | (byte & 0xff);
+        num_bits += 8;
+    }
+
+    ret.resize(out - ret.data());
+    return ret;
+}
+
+template <typename String>
+String ToCustomBaseN::completeAs(String ret) {
+    if (num_bits == 0)
+        return ret;
+
+    ret.assign(alphabet.quantumSymbols(), '=');
+    char* out = flushBuffer(ret.data());
+    if (num_bits > 0) {
+        const size_t mask = (size_t(1) << alphabet.shift()) - 1;
+        *out = alphabet.symbols()[(buffer << (alphabet.shift() - num_bits)) &
+                                  mask];
+    }
+
+    num_bits = 0;
+    return ret;
+}
+
+std::string ToCustomBaseN::snapshot() const {
+    std::string ret;
+    internal::saveNumber(ret, num_bits);
+    internal::saveNumber(ret, internal::lowBits(buffer, num_bits));
+    return ret;
+}
+
+void ToCustomBaseN::restore(std::string_view state) {
+    // Whole quanta are always encoded straight away
+    num_bits = internal::loadNumber(state, alphabet.quantumBits() - 8, 8);
+    buffer = internal::loadNumber(state, internal::lowBits(~0, num_bits));
+    internal::checkStateEnd(state);
+}
+
+void ToCustomBaseN::reset() {
+    buffer = 0;
+    num_bits = 0;
+}
+
+char* ToCustomBaseN::flushBuffer(char* out) {
+    const size_t shift = alphabet.shift();
+    const size_t mask = (size_t(1) << shift) - 1;
+    for (; num_bits >= shift; num_bits -= shift)
+        *out++ = alphabet.symbols()[(buffer >> (num_bits - shift)) & mask];
+    return out;
+}
+
+FromCustomBaseN::FromCustomBaseN(const Alphabet& alphabet)
+    : alphabet(alphabet) {
+}
+
+std::string FromCustomBaseN::process(std::string_view data) {
+    return processAs(data, std::string());
+}
+
+std::pmr::string FromCustomBaseN::process(
+    std::string_view data, std::pmr::memory_resource* resource) {
+    return processAs(data, std::pmr::string(resource));
+}
+
+std::string FromCustomBaseN::complete() {
+    return completeAs(std::string());
+}
+
+std::pmr::string FromCustomBaseN::complete(
+    std::pmr::memory_resource* resource) {
+    return completeAs(std::pmr::string(resource));
+}
+
+template <typename String>
+String FromCustomBaseN::processAs(std::string_view data, String ret) {
+    const size_t shift = alphabet.shift();
+    const size_t quantum_bits = alphabet.quantumBits();
+    const size_t quantum_symbols = alphabet.quantumSymbols();
+    ret.resize(data.size() + quantum_bits / 8);
+    char* out = ret.data();
+
+    while (!data.empty()) {
+        // Whole quanta go through the kernel until one needs a closer look
+        if (padding_bits == 0 && num_bits % quantum_bits == 0) {
+            out = flushBuffer(out);
+            const size_t quanta = decodeQuanta(
+                alphabet, data.data(), data.size() / quantum_symbols, out);
+            data.remove_prefix(quanta * quantum_symbols);
+            out += quanta * (quantum_bits / 8);
+            if (data.empty())
+                break;
+        }
+
+        const char byte =
+            alphabet.inverse()[static_cast<unsigned char>(data[0])];
+        data.remove_prefix(1);
+        if (byte == static_cast<char>(CharCodes::Ignore))
+            continue;
+        if (byte == static_cast<char>(CharCodes::Padding)) {
+            padding_bits += shift;
+            continue;
+        }
+        if (padding_bits > 0)
+            throw std::runtime_error("Invalid padding");
+        if (!alphabet.validByte(byte))
+            throw std::runtime_error("Invalid symbol");
+
+        if (num_bits == quantum_bits)
+            out = flushBuffer(out);
+        buffer = (buffer << shift) | byte;
+        num_bits += shift;
+    }
+
+    ret.resize(out - ret.data());
+    return ret;
+}
+
+template <typename String>
+String FromCustomBaseN::completeAs(String ret) {
+    const size_t quantum_bits = alphabet.quantumBits();
+    if (padding_bits >= quantum_bits)
+        throw std::runtime_error("Too much padding");
+    if ((num_bits + padding_bits) % quantum_bits != 0)
+        throw std::runtime_error("Bad input width");
+    const int zero_mask = (1 << (num_bits % 8)) - 1;
+    if (buffer & zero_mask)
+        throw std::runtime_error("Bad encoding");
+
+    ret.resize(num_bits / 8);
+    flushBuffer(ret.data());
+    if (num_bits >= alphabet.shift())
+        throw std::runtime_error("Invalid padding");
+
+    num_bits = 0;
+    padding_bits = 0;
+    return ret;
+}
+
+std::string FromCustomBaseN::snapshot() const {
+    std::string ret;
+    internal::saveNumber(ret, num_bits);
+    internal::saveNumber(ret, padding_bits);
+    internal::saveNumber(ret, internal::lowBits(buffer, num_bits));
+    return ret;
+}
+
+void FromCustomBaseN::restore(std::string_view state) {
+    const size_t shift = alphabet.shift();
+    num_bits = internal::loadNumber(state, alphabet.quantumBits(), shift);
+    padding_bits = internal::loadNumber(state, UINT8_MAX, shift);
+    buffer = internal::loadNumber(state, internal::lowBits(~0, num_bits));
+    internal::checkStateEnd(state);
+}
+
+void FromCustomBaseN::reset() {
+    buffer = 0;
+    num_bits = 0;
+    padding_bits = 0;
+}
+
+char* FromCustomBaseN::flushBuffer(char* out) {
+    for (; num_bits >= 8; num_bits -= 8)
+        *out++ = buffer >> (num_bits - 8);
+    return out;
+}
+
+}  // namespace textencode
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <textencode/common.hpp>
+
+namespace textencode {
+
+// A base-n alphabet chosen at run time. Decoding ignores the same characters
+// and folds case the same way as the built in alphabets.
+class Alphabet {
+  public:
+    // Throws std::invalid_argument unless there are 2, 4, ... or 64 distinct
+    // symbols, none of them whitespace or '='
+    explicit Alphabet(std::string_view symbols);
+
+    // The built in alphabet of Base16, Base32 or Base64
+    static Alphabet standard(EncodingType type);
+
+    std::string_view symbols() const {
+        return {table.data(), size};
+    }
+    const std::array<char, 256>& inverse() const {
+        return inverse_table;
+    }
+
+    size_t shift() const {
+        return bits;
+    }
+    size_t quantumBits() const {
+        return quantum_bits;
+    }
+    size_t quantumSymbols() const {
+        return quantum_bits / bits;
+    }
+    bool validByte(char byte) const {
+        return (byte & ~((1 << bits) - 1)) == 0;
+    }
+
+  private:
+    std::array<char, 64> table{};
+    std::array<char, 256> inverse_table{};
+    size_t size = 0;
+    size_t bits = 0;
+    size_t quantum_bits = 0;
+};
+
+class ToCustomBaseN : public Converter {
+  public:
+    explicit ToCustomBaseN(const Alphabet& alphabet);
+
+    std::string process(std::string_view data) override;
+    std::pmr::string process(std::string_view data,
+                             std::pmr::memory_resource* resource) override;
+    std::string complete() override;
+    std::pmr::string complete(std::pmr::memory_resource* resource) override;
+    std::string snapshot() const override;
+    void restore(std::string_view state) override;
+    void reset() override;
+
+  private:
+    Alphabet alphabet;
+    uint64_t buffer = 0;
+    uint8_t num_bits = 0;
+
+    template <typename String>
+    String processAs(std::string_view data, String ret);
+    template <typename String>
+    String completeAs(String ret);
+    char* flushBuffer(char* out);
+};
+
+class FromCustomBaseN : public Converter {
+  public:
+    explicit FromCustomBaseN(const Alphabet& alphabet);
+
+    std::string process(std::string_view data) override;
+    std::pmr::string process(std::string_view data,
+                             std::pmr::memory_resource* resource) override;
+    std::string complete() override;
+    std::pmr::string complete(std::pmr::memory_resource* resource) override;
+    std::string snapshot() const override;
+    void restore(std::string_view state) override;
+    void reset() override;
+
+  private:
+    Alphabet alphabet;
+    uint64_t buffer = 0;
+    uint8_t num_bits = 0;
+    uint8_t padding_bits = 0;
+
+    template <typename String>
+    String processAs(std::string_view data, String ret);
+    template <typename String>
+    String completeAs(String ret);
+    char* flushBuffer(char* out);
+};
+
+}  // namespace textencode
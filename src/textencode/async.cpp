@@ -0,0 +1,87 @@
+#include <unistd.h>
+#include <cerrno>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <textencode/async.hpp>
+#include <textencode/common.hpp>
+#include <textencode/map.hpp>
+#include <utility>
+
+namespace textencode {
+
+namespace {
+
+bool wouldBlock(int error) {
+    return error == EAGAIN || error == EWOULDBLOCK;
+}
+
+}  // namespace
+
+AsyncTranscoder::AsyncTranscoder(int fd_in, EncodingType from, int fd_out,
+                                 EncodingType to)
+    : AsyncTranscoder(fd_in, from_binary.at(from)(), fd_out,
+                      to_binary.at(to)()) {
+}
+
+AsyncTranscoder::AsyncTranscoder(int fd_in, std::unique_ptr<Converter> from,
+                                 int fd_out, std::unique_ptr<Converter> to,
+                                 size_t read_size)
+    : fd_in(fd_in),
+      fd_out(fd_out),
+      from(std::move(from)),
+      to(std::move(to)),
+      read_size(read_size) {
+    // A zero byte read() would look like the end of the input
+    if (read_size == 0)
+        throw std::invalid_argument("Read size must not be 0");
+}
+
+AsyncTranscoder::Status AsyncTranscoder::step() {
+    while (current != Status::Done) {
+        while (written < pending.size()) {
+            const ssize_t ret = ::write(fd_out, pending.data() + written,
+                                        pending.size() - written);
+            if (ret < 0 && errno == EINTR)
+                continue;
+            if (ret < 0 && wouldBlock(errno))
+                return current = Status::WantWrite;
+            if (ret < 0)
+                throw std::system_error(errno, std::generic_category(),
+                                        "Failed to write data");
+            written += ret;
+        }
+        pending.clear();
+        written = 0;
+
+        if (eof) {
+            current = Status::Done;
+            break;
+        }
+
+        buffer.resize(read_size);
+        const ssize_t ret = ::read(fd_in, buffer.data(), buffer.size());
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret < 0 && wouldBlock(errno))
+            return current = Status::WantRead;
+        if (ret < 0)
+            throw std::system_error(errno, std::generic_category(),
+                                    "Failed to read data");
+
+        if (ret == 0) {
+            eof = true;
+            pending = to->process(from->complete());
+            pending += to->complete();
+        } else {
+            pending = to->process(
+                from->process(std::string_view(buffer.data(), ret)));
+        }
+    }
+    return current;
+}
+
+}  // namespace textencode
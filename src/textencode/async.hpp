@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <textencode/common.hpp>
+
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+#include <coroutine>
+#include <exception>
+#include <utility>
+#endif
+
+namespace textencode {
+
+// A transcode() over non-blocking fds that can be resumed where it left
+// off, so one thread can drive many of them from an event loop. The fds
+// aren't owned and must stay open until the transcoder is done.
+class AsyncTranscoder {
+  public:
+    enum class Status {
+        // Call step() again once the input fd is readable
+        WantRead,
+        // Call step() again once the output fd is writable
+        WantWrite,
+        Done,
+    };
+
+    AsyncTranscoder(int fd_in, EncodingType from, int fd_out, EncodingType to);
+    // A read_size of 0 throws std::invalid_argument
+    AsyncTranscoder(int fd_in, std::unique_ptr<Converter> from, int fd_out,
+                    std::unique_ptr<Converter> to, size_t read_size = 1 << 16);
+
+    // Reads, converts and writes until an fd would block or everything has
+    // been written. Conversion and I/O errors are thrown.
+    Status step();
+
+    Status status() const {
+        return current;
+    }
+    int inputFd() const {
+        return fd_in;
+    }
+    int outputFd() const {
+        return fd_out;
+    }
+
+  private:
+    int fd_in, fd_out;
+    std::unique_ptr<Converter> from, to;
+    size_t read_size;
+    Status current = Status::WantRead;
+    bool eof = false;
+
+    // Converted output not yet written, which is drained before reading more
+    std::string buffer, pending;
+    size_t written = 0;
+};
+
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+
+// A lazily started coroutine, run either by co_await from another
+// coroutine or by start() from plain code
+class AsyncTask {
+  public:
+    struct promise_type {
+        std::coroutine_handle<> continuation;
+        std::exception_ptr error;
+
+        AsyncTask get_return_object() {
+            return AsyncTask(Handle::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+        auto final_suspend() noexcept {
+            struct Resume {
+                bool await_ready() noexcept {
+                    return false;
+                }
+                std::coroutine_handle<> await_suspend(Handle handle) noexcept {
+                    const auto next = handle.promise().continuation;
+                    return next ? next : std::noop_coroutine();
+                }
+                void await_resume() noexcept {
+                }
+            };
+            return Resume{};
+        }
+        void return_void() {
+        }
+        void unhandled_exception() {
+            error = std::current_exception();
+        }
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    AsyncTask(AsyncTask&& other) noexcept
+        : handle(std::exchange(other.handle, {})) {
+    }
+    AsyncTask& operator=(AsyncTask other) noexcept {
+        std::swap(handle, other.handle);
+        return *this;
+    }
+    ~AsyncTask() {
+        if (handle)
+            handle.destroy();
+    }
+
+    // Runs until the first suspension
+    void start() {
+        handle.resume();
+    }
+    bool done() const {
+        return handle.done();
+    }
+    // Rethrows anything thrown out of a finished coroutine
+    void result() const {
+        if (handle.promise().error)
+            std::rethrow_exception(handle.promise().error);
+    }
+
+    bool await_ready() const {
+        return handle.done();
+    }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) {
+        handle.promise().continuation = caller;
+        return handle;
+    }
+    void await_resume() const {
+        result();
+    }
+
+  private:
+    Handle handle;
+
+    explicit AsyncTask(Handle handle) : handle(handle) {
+    }
+};
+
+// Steps transcoder to completion, suspending on co_await wait(fd, status)
+// each time it would block. wait returns an awaitable resumed by the event
+// loop once fd is readable or writable, as status asks.
+template <typename Wait>
+AsyncTask transcodeAsync(AsyncTranscoder transcoder, Wait wait) {
+    using Status = AsyncTranscoder::Status;
+    for (Status status; (status = transcoder.step()) != Status::Done;) {
+        const int fd = status == Status::WantRead ? transcoder.inputFd()
+                                                  : transcoder.outputFd();
+        co_await wait(fd, status);
+    }
+}
+
+#endif
+
+}  // namespace textencode
@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <textencode/base58.hpp>
+#include <textencode/internal/base58.hpp>
+#include <textencode/internal/common.hpp>
+#include <textencode/internal/radix.hpp>
+#include <textencode/internal/state.hpp>
+#include <textencode/internal/utils.hpp>
+#include <vector>
+
+namespace textencode {
+
+using internal::CharCodes;
+using internal::Limbs;
+using internal::RadixConverter;
+
+namespace {
+
+constexpr auto& symbols = internal::base58_symbols;
+constexpr auto& inverse = internal::base58_inverse;
+
+// Each limb of the encoded number holds 10 symbols
+constexpr uint64_t symbols_radix = 430804206899405824ull;  // 58^10
+constexpr size_t limb_symbols = 10;
+// and each chunk of input 7 bytes, which stays below symbols_radix
+constexpr size_t chunk_bytes = 7;
+
+// Groups big endian digits of the given radix into chunks of chunk_size,
+// leaving any short chunk at the front
+template <uint64_t digit_radix>
+std::vector<uint64_t> toChunks(std::string_view digits, size_t chunk_size) {
+    std::vector<uint64_t> ret;
+    ret.reserve(digits.size() / chunk_size + 1);
+    size_t size = digits.size() % chunk_size;
+    if (size == 0)
+        size = chunk_size;
+    for (size_t pos = 0; pos < digits.size(); pos += size, size = chunk_size) {
+        uint64_t chunk = 0;
+        for (size_t i = pos; i < pos + size; ++i)
+            chunk = chunk * digit_radix + (digits[i] & 0xff);
+        ret.push_back(chunk);
+    }
+    return ret;
+}
+
+size_t leadingZeroes(std::string_view data) {
+    return std::find_if(data.begin(), data.end(),
+                        [](char c) { return c != 0; }) -
+           data.begin();
+}
+
+}  // namespace
+
+ToBase58::ToBase58(std::pmr::memory_resource* resource) : input(resource) {
+}
+
+std::string ToBase58::process(std::string_view data) {
+    input += data;
+    return {};
+}
+
+std::pmr::string ToBase58::process(std::string_view data,
+                                   std::pmr::memory_resource* resource) {
+    input += data;
+    return std::pmr::string(resource);
+}
+
+std::string ToBase58::complete() {
+    return completeAs(std::string());
+}
+
+std::pmr::string ToBase58::complete(std::pmr::memory_resource* resource) {
+    return completeAs(std::pmr::string(resource));
+}
+
+template <typename String>
+String ToBase58::completeAs(String ret) {
+    // Leading zero bytes would vanish from the number, so each gets a '1'
+    const size_t zeroes = leadingZeroes(input);
+    const std::vector<uint64_t> chunks = toChunks<256>(
+        std::string_view(input).substr(zeroes), chunk_bytes);
+    const Limbs limbs = RadixConverter<symbols_radix>(uint64_t(1) << 56)
+                            .convert(chunks.data(), chunks.size());
+    input.clear();
+
+    ret.assign(zeroes + limbs.size() * limb_symbols, symbols[0]);
+    char* out = ret.data() + ret.size();
+    for (uint64_t limb : limbs) {
+        for (size_t i = 0; i < limb_symbols; ++i, limb /= 58)
+            *--out = symbols[limb % 58];
+    }
+
+    // Only the most significant limb has padding to drop
+    const size_t padding =
+        std::find_if(ret.begin() + zeroes, ret.end(),
+                     [](char c) { return c != symbols[0]; }) -
+        ret.begin() - zeroes;
+    ret.erase(zeroes, padding);
+    return ret;
+}
+
+std::string ToBase58::snapshot() const {
+    return std::string(input);
+}
+
+void ToBase58::restore(std::string_view state) {
+    input = state;
+}
+
+void ToBase58::reset() {
+    internal::clearBuffer(input);
+}
+
+FromBase58::FromBase58(std::pmr::memory_resource* resource)
+    : input(resource) {
+}
+
+std::string FromBase58::process(std::string_view data) {
+    for (const char symbol : data) {
+        const char value = inverse[static_cast<unsigned char>(symbol)];
+        if (value == static_cast<char>(CharCodes::Ignore))
+            continue;
+        if (value < 0)
+            throw std::runtime_error("Invalid symbol");
+        input += value;
+    }
+    return {};
+}
+
+std::pmr::string FromBase58::process(std::string_view data,
+                                     std::pmr::memory_resource* resource) {
+    process(data);
+    return std::pmr::string(resource);
+}
+
+std::string FromBase58::complete() {
+    return completeAs(std::string());
+}
+
+std::pmr::string FromBase58::complete(std::pmr::memory_resource* resource) {
+    return completeAs(std::pmr::string(resource));
+}
+
+template <typename String>
+String FromBase58::completeAs(String ret) {
+    const size_t zeroes = leadingZeroes(input);
+    const std::vector<uint64_t> chunks = toChunks<58>(
+        std::string_view(input).substr(zeroes), limb_symbols);
+    const Limbs limbs = RadixConverter<0>(symbols_radix)
+                            .convert(chunks.data(), chunks.size());
+    input.clear();
+
+    ret.assign(zeroes + limbs.size() * 8, '\0');
+    char* out = ret.data() + ret.size();
+    for (uint64_t limb : limbs) {
+        for (size_t i = 0; i < 8; ++i, limb >>= 8)
+            *--out = limb;
+    }
+
+    const size_t padding =
+        std::find_if(ret.begin() + zeroes, ret.end(),
+                     [](char c) { return c != 0; }) -
+        ret.begin() - zeroes;
+    ret.erase(zeroes, padding);
+    return ret;
+}
+
+std::string FromBase58::snapshot() const {
+    return std::string(input);
+}
+
+void FromBase58::restore(std::string_view state) {
+    for (const char value : state)
+        if (value < 0 || value >= 58)
+            throw std::invalid_argument("Invalid converter state");
+    input = state;
+}
+
+void FromBase58::reset() {
+    internal::clearBuffer(input);
+}
+
+}  // namespace textencode
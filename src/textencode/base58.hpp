@@ -0,0 +1,56 @@
+#pragma once
+
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <textencode/common.hpp>
+
+namespace textencode {
+
+// Base58 with the Bitcoin alphabet. Every output symbol depends on the whole
+// input, so like ToNix32 the input is buffered until complete(), allocated
+// from the given resource.
+class ToBase58 : public Converter {
+  public:
+    explicit ToBase58(std::pmr::memory_resource* resource =
+                          std::pmr::get_default_resource());
+
+    std::string process(std::string_view data) override;
+    std::pmr::string process(std::string_view data,
+                             std::pmr::memory_resource* resource) override;
+    std::string complete() override;
+    std::pmr::string complete(std::pmr::memory_resource* resource) override;
+    std::string snapshot() const override;
+    void restore(std::string_view state) override;
+    void reset() override;
+
+  private:
+    std::pmr::string input;
+
+    template <typename String>
+    String completeAs(String ret);
+};
+
+class FromBase58 : public Converter {
+  public:
+    explicit FromBase58(std::pmr::memory_resource* resource =
+                            std::pmr::get_default_resource());
+
+    std::string process(std::string_view data) override;
+    std::pmr::string process(std::string_view data,
+                             std::pmr::memory_resource* resource) override;
+    std::string complete() override;
+    std::pmr::string complete(std::pmr::memory_resource* resource) override;
+    std::string snapshot() const override;
+    void restore(std::string_view state) override;
+    void reset() override;
+
+  private:
+    // Symbol values, validated as they arrive
+    std::pmr::string input;
+
+    template <typename String>
+    String completeAs(String ret);
+};
+
+}  // namespace textencode
@@ -0,0 +1,276 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <textencode/base85.hpp>
+#include <textencode/common.hpp>
+#include <textencode/internal/base85.hpp>
+#include <textencode/internal/common.hpp>
+#include <textencode/internal/state.hpp>
+
+namespace textencode {
+
+using internal::Base85Common;
+using internal::CharCodes;
+
+template <EncodingType type>
+std::string ToBase85<type>::process(std::string_view data) {
+    return processAs(data, std::string());
+}
+
+template <EncodingType type>
+std::pmr::string ToBase85<type>::process(
+    std::string_view data, std::pmr::memory_resource* resource) {
+    return processAs(data, std::pmr::string(resource));
+}
+
+template <EncodingType type>
+std::string ToBase85<type>::complete() {
+    return completeAs(std::string());
+}
+
+template <EncodingType type>
+std::pmr::string ToBase85<type>::complete(
+    std::pmr::memory_resource* resource) {
+    return completeAs(std::pmr::string(resource));
+}
+
+template <EncodingType type>
+template <typename String>
+String ToBase85<type>::processAs(std::string_view data, String ret) {
+    using Common = Base85Common<type>;
+    constexpr size_t word_bytes = Common::word_bytes;
+
+    ret.resize((num_bytes + data.size()) / word_bytes * Common::word_symbols);
+    char* out = ret.data();
+
+    // Top up the partial word left by the last call
+    for (; num_bytes > 0 && num_bytes < word_bytes && !data.empty();
+         data.remove_prefix(1)) {
+        buffer = (buffer << 8) | (data[0] & 0xff);
+        num_bytes += 1;
+    }
+    if (num_bytes == word_bytes && Common::zero_word && buffer == 0) {
+        *out++ = 'z';
+        num_bytes = 0;
+    } else if (num_bytes == word_bytes) {
+        char word[word_bytes];
+        internal::storeWord(buffer, word);
+        internal::encodeWords<type>(word, 1, out);
+        out += Common::word_symbols;
+        buffer = 0;
+        num_bytes = 0;
+    }
+
+    const size_t words = data.size() / word_bytes;
+    const char* in = data.data();
+    size_t start = 0;
+    if constexpr (Common::zero_word) {
+        for (size_t w = 0; w < words; ++w) {
+            if (internal::loadWord(in + w * word_bytes) != 0)
+                continue;
+            internal::encodeWords<type>(in + start * word_bytes, w - start,
+                                        out);
+            out += (w - start) * Common::word_symbols;
+            *out++ = 'z';
+            start = w + 1;
+        }
+    }
+    internal::encodeWords<type>(in + start * word_bytes, words - start, out);
+    out += (words - start) * Common::word_symbols;
+
+    for (const char byte : data.substr(words * word_bytes)) {
+        buffer = (buffer << 8) | (byte & 0xff);
+        num_bytes += 1;
+    }
+
+    ret.resize(out - ret.data());
+    return ret;
+}
+
+template <EncodingType type>
+template <typename String>
+String ToBase85<type>::completeAs(String ret) {
+    using Common = Base85Common<type>;
+    if (num_bytes == 0)
+        return ret;
+
+    char word[Common::word_bytes] = {};
+    internal::storeWord(buffer << (Common::word_bytes - num_bytes) * 8, word);
+    ret.resize(Common::word_symbols);
+    internal::encodeWords<type>(word, 1, ret.data());
+    ret.resize(num_bytes + 1);
+
+    buffer = 0;
+    num_bytes = 0;
+    return ret;
+}
+
+template <EncodingType type>
+std::string ToBase85<type>::snapshot() const {
+    std::string ret;
+    internal::saveNumber(ret, num_bytes);
+    internal::saveNumber(ret, internal::lowBits(buffer, num_bytes * 8));
+    return ret;
+}
+
+template <EncodingType type>
+void ToBase85<type>::restore(std::string_view state) {
+    // A whole word is always encoded straight away
+    num_bytes =
+        internal::loadNumber(state, Base85Common<type>::word_bytes - 1);
+    buffer = internal::loadNumber(state, internal::lowBits(~0, num_bytes * 8));
+    internal::checkStateEnd(state);
+}
+
+template <EncodingType type>
+void ToBase85<type>::reset() {
+    buffer = 0;
+    num_bytes = 0;
+}
+
+template class ToBase85<EncodingType::Ascii85>;
+template class ToBase85<EncodingType::Z85>;
+
+template <EncodingType type>
+std::string FromBase85<type>::process(std::string_view data) {
+    return processAs(data, std::string());
+}
+
+template <EncodingType type>
+std::pmr::string FromBase85<type>::process(
+    std::string_view data, std::pmr::memory_resource* resource) {
+    return processAs(data, std::pmr::string(resource));
+}
+
+template <EncodingType type>
+std::string FromBase85<type>::complete() {
+    return completeAs(std::string());
+}
+
+template <EncodingType type>
+std::pmr::string FromBase85<type>::complete(
+    std::pmr::memory_resource* resource) {
+    return completeAs(std::pmr::string(resource));
+}
+
+template <EncodingType type>
+template <typename String>
+String FromBase85<type>::processAs(std::string_view data, String ret) {
+    using Common = Base85Common<type>;
+    size_t size = (data.size() / Common::word_symbols + 1) * Common::word_bytes;
+    if constexpr (Common::zero_word)
+        size += std::count(data.begin(), data.end(), 'z') * Common::word_bytes;
+
+    ret.resize(size);
+    ret.resize(decode(data, ret.data()) - ret.data());
+    return ret;
+}
+
+template <EncodingType type>
+template <typename String>
+String FromBase85<type>::completeAs(String ret) {
+    ret.resize(Base85Common<type>::word_bytes);
+    ret.resize(finish(ret.data()) - ret.data());
+    return ret;
+}
+
+template <EncodingType type>
+std::string FromBase85<type>::snapshot() const {
+    std::string ret;
+    internal::saveNumber(ret, num_symbols);
+    internal::saveNumber(ret, buffer);
+    return ret;
+}
+
+template <EncodingType type>
+void FromBase85<type>::restore(std::string_view state) {
+    num_symbols =
+        internal::loadNumber(state, Base85Common<type>::word_symbols - 1);
+    uint64_t max = 1;
+    for (size_t i = 0; i < num_symbols; ++i)
+        max *= 85;
+    buffer = internal::loadNumber(state, max - 1);
+    internal::checkStateEnd(state);
+}
+
+template <EncodingType type>
+void FromBase85<type>::reset() {
+    buffer = 0;
+    num_symbols = 0;
+}
+
+template <EncodingType type>
+char* FromBase85<type>::decode(std::string_view data, char* out) {
+    using Common = Base85Common<type>;
+    constexpr size_t word_symbols = Common::word_symbols;
+
+    while (!data.empty()) {
+        // Whole groups go through the kernel until one needs a closer look
+        if (num_symbols == 0) {
+            const size_t words = internal::decodeWords<type>(
+                data.data(), data.size() / word_symbols, out);
+            data.remove_prefix(words * word_symbols);
+            out += words * Common::word_bytes;
+            if (data.empty())
+                break;
+        }
+
+        const char symbol = data[0];
+        data.remove_prefix(1);
+        if (Common::zero_word && symbol == 'z') {
+            if (num_symbols > 0)
+                throw std::runtime_error("Invalid zero word");
+            out = internal::storeWord(0, out);
+            continue;
+        }
+
+        const char byte = Common::inverse[static_cast<unsigned char>(symbol)];
+        if (byte == static_cast<char>(CharCodes::Ignore))
+            continue;
+        if (byte < 0)
+            throw std::runtime_error("Invalid symbol");
+
+        buffer = buffer * 85 + byte;
+        if (++num_symbols == word_symbols) {
+            if (buffer > UINT32_MAX)
+                throw std::runtime_error("Word overflow");
+            out = internal::storeWord(buffer, out);
+            buffer = 0;
+            num_symbols = 0;
+        }
+    }
+
+    return out;
+}
+
+template <EncodingType type>
+char* FromBase85<type>::finish(char* out) {
+    using Common = Base85Common<type>;
+    if (num_symbols == 0)
+        return out;
+    if (num_symbols == 1)
+        throw std::runtime_error("Bad input width");
+
+    // Padding with the highest symbol rounds the truncated word back up
+    const size_t num_bytes = num_symbols - 1;
+    for (; num_symbols < Common::word_symbols; ++num_symbols)
+        buffer = buffer * 85 + 84;
+    if (buffer > UINT32_MAX)
+        throw std::runtime_error("Word overflow");
+
+    char word[Common::word_bytes];
+    internal::storeWord(buffer, word);
+    out = std::copy(word, word + num_bytes, out);
+
+    buffer = 0;
+    num_symbols = 0;
+    return out;
+}
+
+template class FromBase85<EncodingType::Ascii85>;
+template class FromBase85<EncodingType::Z85>;
+
+}  // namespace textencode
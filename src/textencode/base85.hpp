@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <textencode/common.hpp>
+
+namespace textencode {
+
+// A final partial word of n bytes is written as n + 1 symbols, as in
+// Ascii85, for both alphabets
+template <EncodingType type>
+class ToBase85 : public Converter {
+  public:
+    std::string process(std::string_view data) override;
+    std::pmr::string process(std::string_view data,
+                             std::pmr::memory_resource* resource) override;
+    std::string complete() override;
+    std::pmr::string complete(std::pmr::memory_resource* resource) override;
+    std::string snapshot() const override;
+    void restore(std::string_view state) override;
+    void reset() override;
+
+  private:
+    uint32_t buffer = 0;
+    uint8_t num_bytes = 0;
+
+    template <typename String>
+    String processAs(std::string_view data, String ret);
+    template <typename String>
+    String completeAs(String ret);
+};
+
+using ToAscii85 = ToBase85<EncodingType::Ascii85>;
+using ToZ85 = ToBase85<EncodingType::Z85>;
+
+template <EncodingType type>
+class FromBase85 : public Converter {
+  public:
+    std::string process(std::string_view data) override;
+    std::pmr::string process(std::string_view data,
+                             std::pmr::memory_resource* resource) override;
+    std::string complete() override;
+    std::pmr::string complete(std::pmr::memory_resource* resource) override;
+    std::string snapshot() const override;
+    void restore(std::string_view state) override;
+    void reset() override;
+
+  private:
+    uint64_t buffer = 0;
+    uint8_t num_symbols = 0;
+
+    template <typename String>
+    String processAs(std::string_view data, String ret);
+    template <typename String>
+    String completeAs(String ret);
+    char* decode(std::string_view data, char* out);
+    char* finish(char* out);
+};
+
+using FromAscii85 = FromBase85<EncodingType::Ascii85>;
+using FromZ85 = FromBase85<EncodingType::Z85>;
+
+}  // namespace textencode
@@ -1,23 +1,40 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <memory_resource>
 #include <string>
 #include <string_view>
 #include <textencode/common.hpp>
 
 namespace textencode {
+inline namespace TEXTENCODE_MODE {
 
 template <EncodingType type>
 class ToBaseN : public Converter {
   public:
     std::string process(std::string_view data) override;
+    std::pmr::string process(std::string_view data,
+                             std::pmr::memory_resource* resource) override;
     std::string complete() override;
+    std::pmr::string complete(std::pmr::memory_resource* resource) override;
+    std::string snapshot() const override;
+    void restore(std::string_view state) override;
+    void reset() override;
 
   private:
     uint64_t buffer = 0;
     uint8_t num_bits = 0;
 
-    void flushBuffer(std::string& out);
+    // The bodies of both overloads of process() and complete(), which
+    // write to ret with its allocator
+    template <typename String>
+    String processAs(std::string_view data, String ret);
+    template <typename String>
+    String completeAs(String ret);
+
+    template <typename String>
+    void flushBuffer(String& out);
     static char toSymbol(char byte);
 };
 
@@ -29,18 +46,40 @@ template <EncodingType type>
 class FromBaseN : public Converter {
   public:
     std::string process(std::string_view data) override;
+    std::pmr::string process(std::string_view data,
+                             std::pmr::memory_resource* resource) override;
     std::string complete() override;
+    std::pmr::string complete(std::pmr::memory_resource* resource) override;
+    std::string snapshot() const override;
+    void restore(std::string_view state) override;
+    void reset() override;
+
+    // Decodes data over its own front, returning the decoded size
+    static size_t decodeInPlace(char* data, size_t size);
 
   private:
     uint64_t buffer = 0;
     uint8_t num_bits = 0;
     uint8_t padding_bits = 0;
 
-    void flushBuffer(std::string& out);
+    template <typename String>
+    String processAs(std::string_view data, String ret);
+    template <typename String>
+    String completeAs(String ret);
+
+    // Both write through out, which may alias the data already consumed
+    char* decode(std::string_view data, char* out);
+    char* finish(char* out);
+    char* flushBuffer(char* out);
 };
 
 using FromBase16 = FromBaseN<EncodingType::Base16>;
 using FromBase32 = FromBaseN<EncodingType::Base32>;
 using FromBase64 = FromBaseN<EncodingType::Base64>;
 
+}  // namespace TEXTENCODE_MODE
 }  // namespace textencode
+
+#ifdef TEXTENCODE_HEADER_ONLY
+#include <textencode/impl/base_n.hpp>
+#endif
@@ -0,0 +1,270 @@
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <textencode/batch.hpp>
+#include <textencode/common.hpp>
+#include <textencode/fd.hpp>
+#include <textencode/internal/base_n.hpp>
+#include <textencode/internal/common.hpp>
+#include <textencode/internal/fd.hpp>
+#include <textencode/map.hpp>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace textencode {
+
+namespace {
+
+constexpr size_t buffer_size = 1 << 20;
+
+class File {
+  public:
+    File(const std::string& path, int flags)
+        : fd(::open(path.c_str(), flags, 0666)) {
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(),
+                                    "Failed to open " + path);
+    }
+    ~File() {
+        close(fd);
+    }
+    File(const File&) = delete;
+    File& operator=(const File&) = delete;
+
+    const int fd;
+};
+
+// The bytes encoded independently of their neighbours and their symbols
+template <EncodingType type>
+constexpr std::pair<size_t, size_t> quantum() {
+    using Common = internal::Common<type>;
+    return {Common::quantum_bits / 8, Common::quantum_symbols};
+}
+
+std::pair<size_t, size_t> quantum(EncodingType to) {
+    switch (to) {
+        case EncodingType::Base16:
+            return quantum<EncodingType::Base16>();
+        case EncodingType::Base32:
+            return quantum<EncodingType::Base32>();
+        case EncodingType::Base64:
+            return quantum<EncodingType::Base64>();
+        case EncodingType::Z85:
+            return {4, 5};
+        default:
+            return {1, 1};
+    }
+}
+
+// A whole file, or with size set, the piece at offset
+struct Task {
+    size_t file;
+    uint64_t offset = 0;
+    uint64_t size = 0;
+};
+
+// Buffers and totals kept by each thread across its tasks
+struct Worker {
+    std::string buffer;
+    uint64_t bytes_in = 0;
+    uint64_t bytes_out = 0;
+};
+
+void convertFile(const BatchFile& file, EncodingType from, EncodingType to,
+                 Worker& worker) {
+    File in(file.input, O_RDONLY);
+    File out(file.output, O_WRONLY | O_CREAT | O_TRUNC);
+    auto decoder = acquire(from_binary, from);
+    auto encoder = acquire(to_binary, to);
+    auto emit = [&](const std::string& data) {
+        internal::write(out.fd, data);
+        worker.bytes_out += data.size();
+    };
+
+    for (;;) {
+        worker.buffer.clear();
+        if (!internal::readAppend(in.fd, worker.buffer, buffer_size))
+            break;
+        worker.bytes_in += worker.buffer.size();
+        emit(encoder->process(decoder->process(worker.buffer)));
+    }
+    emit(encoder->process(decoder->complete()));
+    emit(encoder->complete());
+}
+
+void convertPiece(const BatchFile& file, const Task& task, EncodingType to,
+                  Worker& worker) {
+    File in(file.input, O_RDONLY);
+    File out(file.output, O_WRONLY);
+    auto encoder = acquire(to_binary, to);
+    const auto [quantum_bytes, quantum_symbols] = quantum(to);
+    off_t out_offset = task.offset / quantum_bytes * quantum_symbols;
+    auto emit = [&](const std::string& data) {
+        const ssize_t ret =
+            pwrite(out.fd, data.data(), data.size(), out_offset);
+        if (ret < 0)
+            throw std::system_error(errno, std::generic_category(),
+                                    "Failed to write data");
+        if (static_cast<size_t>(ret) != data.size())
+            throw std::runtime_error("Failed to write data");
+        out_offset += data.size();
+        worker.bytes_out += data.size();
+    };
+
+    const uint64_t end = task.offset + task.size;
+    for (uint64_t offset = task.offset; offset < end;) {
+        worker.buffer.resize(std::min<uint64_t>(buffer_size, end - offset));
+        const ssize_t ret = pread(in.fd, worker.buffer.data(),
+                                  worker.buffer.size(), offset);
+        if (ret < 0)
+            throw std::system_error(errno, std::generic_category(),
+                                    "Failed to read data");
+        if (ret == 0)
+            throw std::runtime_error("File shrank while reading");
+        worker.buffer.resize(ret);
+        offset += ret;
+        worker.bytes_in += ret;
+        emit(encoder->process(worker.buffer));
+    }
+    // Only the last piece can end in a partial quantum
+    emit(encoder->complete());
+}
+
+// Two files writing the same output would race on it, and an output that is
+// its own input would be truncated before being read, so both are refused
+// before anything is converted. Outputs that already exist are compared by
+// inode, catching other paths to the same file.
+void checkOutputs(const std::vector<BatchFile>& files) {
+    std::vector<std::string> outputs;
+    for (const auto& file : files)
+        outputs.push_back(file.output);
+    checkDistinctFiles(outputs);
+
+    for (const auto& file : files) {
+        struct stat out, in;
+        if (stat(file.output.c_str(), &out) == 0 &&
+            stat(file.input.c_str(), &in) == 0 &&
+            in.st_dev == out.st_dev && in.st_ino == out.st_ino)
+            throw std::invalid_argument(file.input + " would be overwritten");
+    }
+}
+
+}  // namespace
+
+bool splittable(EncodingType from, EncodingType to) {
+    return from == EncodingType::Binary &&
+           (to == EncodingType::Binary || to == EncodingType::Base16 ||
+            to == EncodingType::Base32 || to == EncodingType::Base64 ||
+            to == EncodingType::Z85);
+}
+
+std::pair<uint64_t, uint64_t> shardRange(uint64_t size, size_t index,
+                                         size_t count, EncodingType from,
+                                         EncodingType to) {
+    if (index >= count)
+        throw std::invalid_argument("Shard index out of range");
+    const uint64_t align = splittable(from, to) ? quantum(to).first : 1;
+    // Split without computing size * i, which could overflow
+    auto boundary = [&](size_t i) -> uint64_t {
+        if (i == count)
+            return size;
+        return (size / count * i + size % count * i / count) / align * align;
+    };
+    return {boundary(index), boundary(index + 1)};
+}
+
+BatchSummary transcodeFiles(const std::vector<BatchFile>& files,
+                            EncodingType from, EncodingType to,
+                            size_t threads, size_t split_size) {
+    checkOutputs(files);
+    const auto start = std::chrono::steady_clock::now();
+    if (threads == 0)
+        threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+
+    BatchSummary summary;
+    summary.files = files.size();
+    // The first error of each file, reported in input order
+    std::vector<std::string> errors(files.size());
+    std::mutex mutex;
+    auto fail = [&](size_t file, const std::exception& e) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (errors[file].empty())
+            errors[file] = e.what();
+    };
+
+    // Pieces start on quantum boundaries, so none but the last is padded
+    const size_t piece_size =
+        split_size / quantum(to).first * quantum(to).first;
+    std::vector<Task> tasks;
+    for (size_t i = 0; i < files.size(); ++i) {
+        struct stat st;
+        if (piece_size == 0 || !splittable(from, to) ||
+            stat(files[i].input.c_str(), &st) != 0 ||
+            static_cast<uint64_t>(st.st_size) <= piece_size) {
+            tasks.push_back({i});
+            continue;
+        }
+        try {
+            const File create(files[i].output, O_WRONLY | O_CREAT | O_TRUNC);
+        } catch (const std::exception& e) {
+            fail(i, e);
+            continue;
+        }
+        const uint64_t size = st.st_size;
+        for (uint64_t offset = 0; offset < size; offset += piece_size)
+            tasks.push_back(
+                {i, offset, std::min<uint64_t>(piece_size, size - offset)});
+    }
+
+    std::atomic<size_t> next = 0;
+    std::vector<Worker> workers(std::min(threads, tasks.size()));
+    auto work = [&](Worker& worker) {
+        for (size_t t; (t = next++) < tasks.size();) {
+            const Task& task = tasks[t];
+            try {
+                if (task.size == 0)
+                    convertFile(files[task.file], from, to, worker);
+                else
+                    convertPiece(files[task.file], task, to, worker);
+            } catch (const std::exception& e) {
+                fail(task.file, e);
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < workers.size(); ++i)
+        pool.emplace_back(work, std::ref(workers[i]));
+    if (!workers.empty())
+        work(workers[0]);
+    for (auto& thread : pool)
+        thread.join();
+
+    for (size_t i = 0; i < files.size(); ++i)
+        if (!errors[i].empty())
+            summary.failures.push_back({files[i].input, errors[i]});
+    for (const auto& worker : workers) {
+        summary.bytes_in += worker.bytes_in;
+        summary.bytes_out += worker.bytes_out;
+    }
+    summary.seconds = std::chrono::duration<double>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+    return summary;
+}
+
+}  // namespace textencode
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <textencode/common.hpp>
+#include <utility>
+#include <vector>
+
+namespace textencode {
+
+struct BatchFile {
+    std::string input;
+    std::string output;
+};
+
+struct BatchFailure {
+    std::string path;
+    std::string error;
+};
+
+struct BatchSummary {
+    size_t files = 0;
+    uint64_t bytes_in = 0;
+    uint64_t bytes_out = 0;
+    double seconds = 0;
+    std::vector<BatchFailure> failures;
+};
+
+// Whether a file can be converted as independent pieces written at known
+// output offsets. This holds when encoding binary to a fixed width encoding.
+bool splittable(EncodingType from, EncodingType to);
+
+// The input range [first, second) of shard index out of count over size
+// bytes. Shards of a splittable conversion start on quantum boundaries, so
+// each can be converted and completed on its own and the outputs
+// concatenated.
+// Any other shard has to carry on from the previous one's Checkpoint.
+std::pair<uint64_t, uint64_t> shardRange(uint64_t size, size_t index,
+                                         size_t count, EncodingType from,
+                                         EncodingType to);
+
+// Converts each input file to its output file on a pool of threads, where 0
+// threads means one per core. With a split_size, splittable files larger
+// than it are cut into pieces of about that size, which are converted
+// concurrently. Failures are collected in the summary rather than thrown,
+// but std::invalid_argument is thrown up front when two files share an
+// output or an output is the file's own input.
+BatchSummary transcodeFiles(const std::vector<BatchFile>& files,
+                            EncodingType from, EncodingType to,
+                            size_t threads = 0, size_t split_size = 0);
+
+}  // namespace textencode
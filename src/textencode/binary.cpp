@@ -1,5 +1,7 @@
+#include <memory_resource>
 #include <string>
 #include <textencode/binary.hpp>
+#include <textencode/internal/state.hpp>
 
 namespace textencode {
 
@@ -7,8 +9,28 @@ std::string Binary::process(std::string_view data) {
     return std::string(data);
 }
 
+std::pmr::string Binary::process(std::string_view data,
+                                 std::pmr::memory_resource* resource) {
+    return std::pmr::string(data, resource);
+}
+
 std::string Binary::complete() {
     return {};
 }
 
+std::pmr::string Binary::complete(std::pmr::memory_resource* resource) {
+    return std::pmr::string(resource);
+}
+
+std::string Binary::snapshot() const {
+    return {};
+}
+
+void Binary::restore(std::string_view state) {
+    internal::checkStateEnd(state);
+}
+
+void Binary::reset() {
+}
+
 }  // namespace textencode
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <memory_resource>
+#include <string>
+#include <string_view>
 #include <textencode/common.hpp>
 
 namespace textencode {
@@ -7,7 +10,13 @@ namespace textencode {
 class Binary : public Converter {
   public:
     std::string process(std::string_view data) override;
+    std::pmr::string process(std::string_view data,
+                             std::pmr::memory_resource* resource) override;
     std::string complete() override;
+    std::pmr::string complete(std::pmr::memory_resource* resource) override;
+    std::string snapshot() const override;
+    void restore(std::string_view state) override;
+    void reset() override;
 };
 
 }  // namespace textencode
@@ -0,0 +1,246 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <textencode/column.hpp>
+#include <textencode/common.hpp>
+#include <textencode/internal/base85.hpp>
+#include <textencode/internal/base_n.hpp>
+#include <textencode/internal/common.hpp>
+#include <textencode/internal/nix.hpp>
+#include <textencode/map.hpp>
+#include <thread>
+#include <vector>
+
+namespace textencode {
+
+namespace {
+
+// At most the bytes decoded from size symbols of type
+uint64_t decodedBound(EncodingType type, uint64_t size) {
+    switch (type) {
+        case EncodingType::Base16:
+            return size / 2;
+        case EncodingType::Base32:
+        case EncodingType::Nix32:
+            return size * 5 / 8;
+        case EncodingType::Base64:
+            return size * 3 / 4;
+        case EncodingType::Ascii85:
+            // Each 'z' stands for a whole word
+            return size * 4;
+        default:
+            return size;
+    }
+}
+
+bool exactSize(EncodingType type) {
+    return type != EncodingType::Ascii85 && type != EncodingType::Base58;
+}
+
+// The final partial quantum is encoded from a zero filled copy
+template <EncodingType type>
+char* encodeBaseN(std::string_view in, char* out) {
+    using Common = internal::Common<type>;
+    constexpr size_t quantum_bytes = Common::quantum_bits / 8;
+    const size_t quanta = in.size() / quantum_bytes;
+    internal::encodeQuanta<type>(in.data(), quanta, out);
+    out += quanta * Common::quantum_symbols;
+
+    const size_t tail = in.size() % quantum_bytes;
+    if (tail == 0)
+        return out;
+    char last[quantum_bytes] = {};
+    std::copy(in.end() - tail, in.end(), last);
+    char symbols[Common::quantum_symbols];
+    internal::encodeQuanta<type>(last, 1, symbols);
+    const size_t used = (tail * 8 + Common::shift - 1) / Common::shift;
+    out = std::copy(symbols, symbols + used, out);
+    return std::fill_n(out, Common::quantum_symbols - used, '=');
+}
+
+// As ToBase85::complete(), a partial word of n bytes keeps n + 1 symbols
+char* encodeZ85(std::string_view in, char* out) {
+    constexpr auto type = EncodingType::Z85;
+    const size_t words = in.size() / 4;
+    internal::encodeWords<type>(in.data(), words, out);
+    out += words * 5;
+
+    const size_t tail = in.size() % 4;
+    if (tail == 0)
+        return out;
+    char last[4] = {};
+    std::copy(in.end() - tail, in.end(), last);
+    char symbols[5];
+    internal::encodeWords<type>(last, 1, symbols);
+    return std::copy(symbols, symbols + tail + 1, out);
+}
+
+// Writes bytes encoded as type to out, which has encodedSize() room
+char* encode(EncodingType type, std::string_view bytes, char* out) {
+    switch (type) {
+        case EncodingType::Binary:
+            return std::copy(bytes.begin(), bytes.end(), out);
+        case EncodingType::Base16:
+            return encodeBaseN<EncodingType::Base16>(bytes, out);
+        case EncodingType::Base32:
+            return encodeBaseN<EncodingType::Base32>(bytes, out);
+        case EncodingType::Base64:
+            return encodeBaseN<EncodingType::Base64>(bytes, out);
+        case EncodingType::Nix32:
+            internal::toSymbols(bytes, out);
+            return out + internal::nixSymbols(bytes.size());
+        case EncodingType::Z85:
+            return encodeZ85(bytes, out);
+        default: {
+            const auto encoder = acquire(to_binary, type);
+            std::string ret = encoder->process(bytes);
+            ret += encoder->complete();
+            return std::copy(ret.begin(), ret.end(), out);
+        }
+    }
+}
+
+// Converts values [first, last) into place, recording the sizes written
+// when they aren't exact
+void convertValues(const uint64_t* offsets, size_t first, size_t last,
+                   std::string_view data, EncodingType from, EncodingType to,
+                   Column& out, uint64_t* sizes) {
+    const auto in_place = in_place_from_binary.find(from);
+    // Decoded values go through one buffer reused across them
+    std::string scratch;
+
+    for (size_t i = first; i < last; ++i) {
+        std::string_view bytes =
+            data.substr(offsets[i], offsets[i + 1] - offsets[i]);
+        char* const begin = out.data.data() + out.offsets[i];
+        try {
+            if (from != EncodingType::Binary &&
+                in_place != in_place_from_binary.end()) {
+                scratch.assign(bytes);
+                scratch.resize(in_place->second(scratch.data(), bytes.size()));
+                bytes = scratch;
+            } else if (from != EncodingType::Binary) {
+                const auto decoder = acquire(from_binary, from);
+                scratch = decoder->process(bytes);
+                scratch += decoder->complete();
+                bytes = scratch;
+            }
+            char* const end = encode(to, bytes, begin);
+            if (sizes)
+                sizes[i] = end - begin;
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error("Value " + std::to_string(i) + ": " +
+                                     e.what());
+        }
+    }
+}
+
+}  // namespace
+
+uint64_t encodedSize(EncodingType type, uint64_t size) {
+    switch (type) {
+        case EncodingType::Base16:
+            return size * 2;
+        case EncodingType::Base32:
+            return (size + 4) / 5 * 8;
+        case EncodingType::Base64:
+            return (size + 2) / 3 * 4;
+        case EncodingType::Nix32:
+            return internal::nixSymbols(size);
+        case EncodingType::Ascii85:
+        case EncodingType::Z85:
+            return size + (size + 3) / 4;
+        case EncodingType::Base58:
+            // log(256) / log(58) is below 1.38
+            return size * 138 / 100 + 1;
+        default:
+            return size;
+    }
+}
+
+void convertColumn(const uint64_t* offsets, size_t count,
+                   std::string_view data, EncodingType from, EncodingType to,
+                   Column& out, size_t threads) {
+    threads = std::max<size_t>(threads, 1);
+    if (offsets[0] > data.size())
+        throw std::invalid_argument("Invalid column offsets");
+    for (size_t i = 0; i < count; ++i)
+        if (offsets[i] > offsets[i + 1] || offsets[i + 1] > data.size())
+            throw std::invalid_argument("Invalid column offsets");
+
+    // Where only a bound is known, values are written at bound offsets and
+    // packed together afterwards
+    const bool exact = from == EncodingType::Binary && exactSize(to);
+    out.offsets.resize(count + 1);
+    out.offsets[0] = 0;
+    for (size_t i = 0; i < count; ++i)
+        out.offsets[i + 1] =
+            out.offsets[i] +
+            encodedSize(to, decodedBound(from, offsets[i + 1] - offsets[i]));
+    out.data.resize(out.offsets[count]);
+    std::vector<uint64_t> sizes(exact ? 0 : count);
+    uint64_t* const sizes_data = exact ? nullptr : sizes.data();
+
+    // Each thread takes a run of values with about as many input bytes
+    const uint64_t total = offsets[count] - offsets[0];
+    std::vector<std::exception_ptr> errors(threads);
+    std::vector<std::thread> workers;
+    size_t first = 0;
+    for (size_t t = 0; t < threads; ++t) {
+        size_t last = count;
+        if (t + 1 < threads) {
+            const uint64_t split = offsets[0] + total * (t + 1) / threads;
+            last = std::lower_bound(offsets, offsets + count, split) - offsets;
+            last = std::max(first, last);
+        }
+        auto work = [&, t, first, last]() {
+            try {
+                convertValues(offsets, first, last, data, from, to, out,
+                              sizes_data);
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        };
+        if (t + 1 < threads)
+            workers.emplace_back(work);
+        else
+            work();
+        first = last;
+    }
+    for (auto& worker : workers)
+        worker.join();
+    for (const auto& error : errors)
+        if (error)
+            std::rethrow_exception(error);
+
+    if (exact)
+        return;
+    uint64_t pos = 0;
+    for (size_t i = 0; i < count; ++i) {
+        std::memmove(out.data.data() + pos, out.data.data() + out.offsets[i],
+                     sizes[i]);
+        out.offsets[i] = pos;
+        pos += sizes[i];
+    }
+    out.offsets[count] = pos;
+    out.data.resize(pos);
+}
+
+Column convertColumn(const Column& column, EncodingType from,
+                     EncodingType to, size_t threads) {
+    Column ret;
+    if (column.offsets.empty()) {
+        ret.offsets = {0};
+        return ret;
+    }
+    convertColumn(column.offsets.data(), column.offsets.size() - 1,
+                  column.data, from, to, ret, threads);
+    return ret;
+}
+
+}  // namespace textencode
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <textencode/common.hpp>
+#include <vector>
+
+namespace textencode {
+
+// Variable length values laid out as in Arrow, value i being
+// data[offsets[i], offsets[i + 1]) so there is one more offset than values
+struct Column {
+    std::vector<uint64_t> offsets;
+    std::string data;
+};
+
+// The size of size bytes encoded as type. Ascii85 and base58 only have an
+// upper bound, as zero words and the base conversion vary in length.
+uint64_t encodedSize(EncodingType type, uint64_t size);
+
+// Converts each of the count values of a column independently into out,
+// whose buffers are reused. The output offsets come from the encoded sizes
+// up front, so each value is written straight into place by the encoding
+// kernels, with the values split across the given number of threads. When
+// only an upper bound on a size is known, the values are packed together
+// afterwards. Errors name the failing value, counting from 0.
+void convertColumn(const uint64_t* offsets, size_t count,
+                   std::string_view data, EncodingType from, EncodingType to,
+                   Column& out, size_t threads = 1);
+Column convertColumn(const Column& column, EncodingType from,
+                     EncodingType to, size_t threads = 1);
+
+}  // namespace textencode
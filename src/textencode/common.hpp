@@ -1,8 +1,23 @@
 #pragma once
 
+#include <memory_resource>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 
+// Defining TEXTENCODE_HEADER_ONLY pulls the base-n and nix32 converter
+// definitions into their headers, so they can inline without the library.
+// The converters are declared in an inline namespace named after the mode,
+// so a program may mix header-only code with the library without two
+// definitions of one converter.
+#ifdef TEXTENCODE_HEADER_ONLY
+#define TEXTENCODE_INLINE inline
+#define TEXTENCODE_MODE header_only
+#else
+#define TEXTENCODE_INLINE
+#define TEXTENCODE_MODE library
+#endif
+
 namespace textencode {
 
 enum class EncodingType {
@@ -11,6 +26,14 @@ enum class EncodingType {
     Base32,
     Nix32,
     Base64,
+    Ascii85,
+    Z85,
+    Base58,
+};
+
+enum class DigestType {
+    Sha256,
+    Sha512,
 };
 
 class Converter {
@@ -19,6 +42,37 @@ class Converter {
 
     virtual std::string process(std::string_view data) = 0;
     virtual std::string complete() = 0;
+
+    // As above, with the output allocated from resource. Converters that
+    // don't override these copy the std::string results into resource.
+    virtual std::pmr::string process(std::string_view data,
+                                     std::pmr::memory_resource* resource) {
+        const std::string ret = process(data);
+        return std::pmr::string(ret.data(), ret.size(), resource);
+    }
+    virtual std::pmr::string complete(std::pmr::memory_resource* resource) {
+        const std::string ret = complete();
+        return std::pmr::string(ret.data(), ret.size(), resource);
+    }
+
+    // The state carried between process() calls as a compact blob, which
+    // restore() loads into a fresh converter of the same kind to carry on
+    // where this one stopped. Not every converter supports it, the rest
+    // throw std::runtime_error.
+    virtual std::string snapshot() const {
+        throw std::runtime_error("Converter state can't be saved");
+    }
+    // Throws std::invalid_argument for a state this converter didn't save
+    virtual void restore(std::string_view) {
+        throw std::runtime_error("Converter state can't be restored");
+    }
+
+    // Returns the converter to its initial state, dropping any buffered
+    // input but keeping the capacity of its buffers, up to 1 MiB each, for
+    // the next use
+    virtual void reset() {
+        throw std::runtime_error("Converter can't be reset");
+    }
 };
 
 }  // namespace textencode
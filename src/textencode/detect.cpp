@@ -0,0 +1,293 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <textencode/common.hpp>
+#include <textencode/detect.hpp>
+#include <textencode/internal/base58.hpp>
+#include <textencode/internal/base85.hpp>
+#include <textencode/internal/base_n.hpp>
+#include <textencode/internal/common.hpp>
+#include <textencode/internal/nix.hpp>
+#include <textencode/internal/state.hpp>
+#include <textencode/internal/utils.hpp>
+#include <textencode/map.hpp>
+#include <utility>
+
+namespace textencode {
+
+namespace {
+
+using internal::CharCodes;
+
+enum class Class : unsigned char {
+    Invalid,
+    // In the alphabet as is
+    Symbol,
+    // Accepted by folding to the other case
+    Folded,
+    Space,
+    Padding,
+    // Ascii85's 'z' for a word of zeroes
+    Zero,
+};
+
+using Classes = std::array<Class, 256>;
+
+constexpr Classes makeClasses(const std::array<char, 256>& inverse,
+                              std::string_view symbols) {
+    Classes ret{};
+    for (size_t i = 0; i < ret.size(); ++i) {
+        const char code = inverse[i];
+        if (code == static_cast<char>(CharCodes::Invalid))
+            ret[i] = Class::Invalid;
+        else if (code == static_cast<char>(CharCodes::Ignore))
+            ret[i] = Class::Space;
+        else if (code == static_cast<char>(CharCodes::Padding))
+            ret[i] = Class::Padding;
+        else
+            ret[i] = Class::Folded;
+    }
+    // Not string_view::find(), which isn't a constant expression with
+    // sanitizers
+    for (const char symbol : symbols)
+        ret[static_cast<unsigned char>(symbol)] = Class::Symbol;
+    return ret;
+}
+
+template <EncodingType type>
+constexpr Classes baseNClasses() {
+    using Common = internal::Common<type>;
+    return makeClasses(
+        Common::inverse,
+        std::string_view(Common::symbols.data(), Common::symbols.size()));
+}
+
+template <EncodingType type>
+constexpr Classes base85Classes() {
+    using Common = internal::Base85Common<type>;
+    Classes ret = makeClasses(
+        Common::inverse,
+        std::string_view(Common::symbols.data(), Common::symbols.size()));
+    if constexpr (Common::zero_word)
+        ret['z'] = Class::Zero;
+    return ret;
+}
+
+constexpr Classes base16_classes = baseNClasses<EncodingType::Base16>();
+constexpr Classes base32_classes = baseNClasses<EncodingType::Base32>();
+constexpr Classes nix32_classes = baseNClasses<EncodingType::Nix32>();
+constexpr Classes base64_classes = baseNClasses<EncodingType::Base64>();
+constexpr Classes base58_classes =
+    makeClasses(internal::base58_inverse, internal::base58_symbols);
+constexpr Classes ascii85_classes = base85Classes<EncodingType::Ascii85>();
+constexpr Classes z85_classes = base85Classes<EncodingType::Z85>();
+
+// What a byte histogram holds under one alphabet
+struct Counts {
+    size_t symbols = 0, folded = 0, padding = 0, zeroes = 0, invalid = 0;
+};
+
+Counts count(const std::array<size_t, 256>& histogram,
+             const Classes& classes) {
+    Counts ret;
+    for (size_t i = 0; i < histogram.size(); ++i) {
+        switch (classes[i]) {
+            case Class::Invalid:
+                ret.invalid += histogram[i];
+                break;
+            case Class::Symbol:
+                ret.symbols += histogram[i];
+                break;
+            case Class::Folded:
+                ret.folded += histogram[i];
+                break;
+            case Class::Padding:
+                ret.padding += histogram[i];
+                break;
+            case Class::Zero:
+                ret.zeroes += histogram[i];
+                break;
+            case Class::Space:
+                break;
+        }
+    }
+    return ret;
+}
+
+// The same width rules FromBaseN::finish() applies
+template <EncodingType type>
+bool validBaseNWidth(const Counts& counts) {
+    using Common = internal::Common<type>;
+    const size_t symbols = counts.symbols + counts.folded;
+    return (symbols + counts.padding) % Common::quantum_symbols == 0 &&
+           counts.padding < Common::quantum_symbols &&
+           symbols * Common::shift % 8 < Common::shift;
+}
+
+// The same length rule as nix32's fromValues()
+bool validNixWidth(const Counts& counts) {
+    const size_t size = counts.symbols + counts.folded;
+    return (size + 7) * 5 / 8 != (size + 8) * 5 / 8;
+}
+
+// The decoder's output for data or its final output, allocated like ret
+std::string decode(Converter& decoder, std::string_view data, std::string) {
+    return decoder.process(data);
+}
+std::pmr::string decode(Converter& decoder, std::string_view data,
+                        std::pmr::string ret) {
+    return decoder.process(data, ret.get_allocator().resource());
+}
+std::string finish(Converter& decoder, std::string) {
+    return decoder.complete();
+}
+std::pmr::string finish(Converter& decoder, std::pmr::string ret) {
+    return decoder.complete(ret.get_allocator().resource());
+}
+
+}  // namespace
+
+EncodingType detect(std::string_view data, bool prefix) {
+    // A single pass over the data, after which each alphabet only has to
+    // look at the 256 counts
+    std::array<size_t, 256> histogram{};
+    bool after_padding = false, padding_inside = false;
+    for (const char byte : data) {
+        ++histogram[static_cast<unsigned char>(byte)];
+        if (byte == '=')
+            after_padding = true;
+        else if (after_padding && byte != ' ' && byte != '\r' && byte != '\n')
+            padding_inside = true;
+    }
+
+    const auto fits = [&](const Counts& counts, bool folded, bool padding) {
+        return counts.invalid == 0 && (folded || counts.folded == 0) &&
+               (padding || counts.padding == 0) &&
+               counts.symbols + counts.folded + counts.zeroes > 0;
+    };
+    const bool trailing_padding = !padding_inside;
+
+    const Counts base16 = count(histogram, base16_classes);
+    if (fits(base16, true, trailing_padding) &&
+        (prefix || validBaseNWidth<EncodingType::Base16>(base16)))
+        return EncodingType::Base16;
+
+    // Base32 is upper case and nix32 lower case, though either decodes
+    // the other case too
+    const Counts base32 = count(histogram, base32_classes);
+    const bool base32_width =
+        prefix || validBaseNWidth<EncodingType::Base32>(base32);
+    const Counts nix32 = count(histogram, nix32_classes);
+    const bool nix32_width = prefix || validNixWidth(nix32);
+    for (const bool folded : {false, true}) {
+        if (fits(base32, folded, trailing_padding) && base32_width)
+            return EncodingType::Base32;
+        if (fits(nix32, folded, false) && nix32_width)
+            return EncodingType::Nix32;
+    }
+
+    if (fits(count(histogram, base58_classes), false, false))
+        return EncodingType::Base58;
+
+    const Counts base64 = count(histogram, base64_classes);
+    if (fits(base64, false, trailing_padding) &&
+        (prefix || validBaseNWidth<EncodingType::Base64>(base64)))
+        return EncodingType::Base64;
+
+    // A trailing group of a single symbol can't be decoded
+    const Counts ascii85 = count(histogram, ascii85_classes);
+    if (fits(ascii85, false, false) && (prefix || ascii85.symbols % 5 != 1))
+        return EncodingType::Ascii85;
+    const Counts z85 = count(histogram, z85_classes);
+    if (fits(z85, false, false) && (prefix || z85.symbols % 5 != 1))
+        return EncodingType::Z85;
+
+    return EncodingType::Binary;
+}
+
+FromAuto::FromAuto(size_t prefix_size, std::pmr::memory_resource* resource)
+    : prefix_size(prefix_size), prefix(resource) {
+}
+
+std::string FromAuto::process(std::string_view data) {
+    return processAs(data, std::string());
+}
+
+std::pmr::string FromAuto::process(std::string_view data,
+                                   std::pmr::memory_resource* resource) {
+    return processAs(data, std::pmr::string(resource));
+}
+
+std::string FromAuto::complete() {
+    return completeAs(std::string());
+}
+
+std::pmr::string FromAuto::complete(std::pmr::memory_resource* resource) {
+    return completeAs(std::pmr::string(resource));
+}
+
+template <typename String>
+String FromAuto::processAs(std::string_view data, String ret) {
+    if (decoder)
+        return decode(*decoder, data, std::move(ret));
+    prefix.append(data);
+    if (prefix.size() < prefix_size)
+        return ret;
+    return start(false, std::move(ret));
+}
+
+template <typename String>
+String FromAuto::completeAs(String ret) {
+    if (!decoder)
+        ret = start(true, std::move(ret));
+    ret += finish(*decoder, String(ret.get_allocator()));
+    return ret;
+}
+
+// Either 0 and the prefix so far, or 1 + the detected type and the state of
+// its decoder
+std::string FromAuto::snapshot() const {
+    std::string ret;
+    if (!decoder) {
+        internal::saveNumber(ret, 0);
+        return ret.append(prefix);
+    }
+    internal::saveNumber(ret, 1 + static_cast<uint64_t>(detected));
+    return ret + decoder->snapshot();
+}
+
+void FromAuto::restore(std::string_view state) {
+    const uint64_t type = internal::loadNumber(
+        state, 1 + static_cast<uint64_t>(EncodingType::Base58));
+    if (type == 0) {
+        detected = EncodingType::Binary;
+        decoder.reset();
+        prefix = state;
+        return;
+    }
+    detected = static_cast<EncodingType>(type - 1);
+    decoder = from_binary.at(detected)();
+    decoder->restore(state);
+    prefix.clear();
+}
+
+void FromAuto::reset() {
+    detected = EncodingType::Binary;
+    decoder.reset();
+    internal::clearBuffer(prefix);
+}
+
+template <typename String>
+String FromAuto::start(bool complete, String ret) {
+    detected = detect(prefix, !complete);
+    decoder = from_binary.at(detected)();
+    ret = decode(*decoder, prefix, std::move(ret));
+    prefix.clear();
+    prefix.shrink_to_fit();
+    return ret;
+}
+
+}  // namespace textencode
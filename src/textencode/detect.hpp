@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <textencode/common.hpp>
+
+namespace textencode {
+
+// Guesses the encoding of data from the characters it uses, picking the
+// first that fits of base16, base32, nix32, base58, base64, ascii85 and z85.
+// Base32 and nix32 are told apart by case when both fit. Unless data is
+// only a prefix of the input, the length rules of each encoding apply too.
+// Binary is returned when nothing else fits.
+EncodingType detect(std::string_view data, bool prefix = false);
+
+// Decodes input of any encoding detect() knows, deciding on the encoding
+// once prefix_size bytes have arrived or the input is complete. The prefix
+// is buffered in the given resource.
+class FromAuto : public Converter {
+  public:
+    explicit FromAuto(size_t prefix_size = 1 << 12,
+                      std::pmr::memory_resource* resource =
+                          std::pmr::get_default_resource());
+
+    std::string process(std::string_view data) override;
+    std::pmr::string process(std::string_view data,
+                             std::pmr::memory_resource* resource) override;
+    std::string complete() override;
+    std::pmr::string complete(std::pmr::memory_resource* resource) override;
+    std::string snapshot() const override;
+    void restore(std::string_view state) override;
+    void reset() override;
+
+    // The detected encoding, which is Binary until one has been chosen
+    EncodingType type() const {
+        return detected;
+    }
+
+  private:
+    size_t prefix_size;
+    std::pmr::string prefix;
+    EncodingType detected = EncodingType::Binary;
+    std::unique_ptr<Converter> decoder;
+
+    template <typename String>
+    String processAs(std::string_view data, String ret);
+    template <typename String>
+    String completeAs(String ret);
+    template <typename String>
+    String start(bool complete, String ret);
+};
+
+}  // namespace textencode
@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <textencode/common.hpp>
+#include <textencode/digest.hpp>
+#include <textencode/internal/digest.hpp>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <immintrin.h>
+#define TEXTENCODE_SHA_NI 1
+#endif
+
+namespace textencode {
+
+using internal::Sha2Common;
+
+namespace {
+
+#ifdef TEXTENCODE_SHA_NI
+
+bool haveShaNi() {
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+    const bool sse41 = ecx & bit_SSE4_1;
+    const bool ssse3 = ecx & bit_SSSE3;
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+        return false;
+    return sse41 && ssse3 && (ebx & bit_SHA);
+}
+
+// Four rounds per group, with the message schedule for group i + 3 being
+// finished while group i is hashed
+__attribute__((target("sha,sse4.1,ssse3"))) void compressShaNi(
+    std::array<uint32_t, 8>& state, const char* data, size_t blocks) {
+    constexpr auto& rounds = Sha2Common<DigestType::Sha256>::rounds;
+    const __m128i mask =
+        _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    __m128i tmp = _mm_loadu_si128(reinterpret_cast<__m128i*>(&state[0]));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<__m128i*>(&state[4]));
+    tmp = _mm_shuffle_epi32(tmp, 0xb1);
+    state1 = _mm_shuffle_epi32(state1, 0x1b);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+
+    for (; blocks > 0; --blocks, data += 64) {
+        const __m128i abef = state0;
+        const __m128i cdgh = state1;
+        __m128i w[4];
+
+#pragma GCC unroll 16
+        for (size_t i = 0; i < 16; ++i) {
+            if (i < 4)
+                w[i] = _mm_shuffle_epi8(
+                    _mm_loadu_si128(
+                        reinterpret_cast<const __m128i*>(data + i * 16)),
+                    mask);
+            __m128i msg = _mm_add_epi32(
+                w[i % 4], _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                              &rounds[i * 4])));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+            if (i >= 3 && i <= 14) {
+                auto& next = w[(i + 1) % 4];
+                next = _mm_add_epi32(
+                    next, _mm_alignr_epi8(w[i % 4], w[(i + 3) % 4], 4));
+                next = _mm_sha256msg2_epu32(next, w[i % 4]);
+            }
+            msg = _mm_shuffle_epi32(msg, 0x0e);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+            if (i >= 1 && i <= 12)
+                w[(i + 3) % 4] = _mm_sha256msg1_epu32(w[(i + 3) % 4], w[i % 4]);
+        }
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1b);
+    state1 = _mm_shuffle_epi32(state1, 0xb1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xf0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+
+#endif
+
+template <DigestType type>
+void compress(std::array<typename Sha2Common<type>::Word, 8>& state,
+              const char* data, size_t blocks) {
+#ifdef TEXTENCODE_SHA_NI
+    if constexpr (type == DigestType::Sha256) {
+        static const bool sha_ni = haveShaNi();
+        if (sha_ni)
+            return compressShaNi(state, data, blocks);
+    }
+#endif
+    Sha2Common<type>::compress(state, data, blocks);
+}
+
+}  // namespace
+
+template <DigestType type>
+Sha2<type>::Sha2(std::pmr::memory_resource* resource)
+    : state(Sha2Common<type>::initial), block(resource) {
+}
+
+template <DigestType type>
+std::string Sha2<type>::process(std::string_view data) {
+    constexpr auto block_size = Sha2Common<type>::block_size;
+    length += data.size();
+
+    if (!block.empty()) {
+        const size_t fill = std::min(block_size - block.size(), data.size());
+        block.append(data.data(), fill);
+        data.remove_prefix(fill);
+        if (block.size() < block_size)
+            return {};
+        compress<type>(state, block.data(), 1);
+        block.clear();
+    }
+
+    const size_t blocks = data.size() / block_size;
+    compress<type>(state, data.data(), blocks);
+    data.remove_prefix(blocks * block_size);
+    block.assign(data.data(), data.size());
+
+    return {};
+}
+
+template <DigestType type>
+std::pmr::string Sha2<type>::process(std::string_view data,
+                                    std::pmr::memory_resource* resource) {
+    process(data);
+    return std::pmr::string(resource);
+}
+
+template <DigestType type>
+std::string Sha2<type>::complete() {
+    return completeAs(std::string());
+}
+
+template <DigestType type>
+std::pmr::string Sha2<type>::complete(std::pmr::memory_resource* resource) {
+    return completeAs(std::pmr::string(resource));
+}
+
+template <DigestType type>
+template <typename String>
+String Sha2<type>::completeAs(String ret) {
+    constexpr auto block_size = Sha2Common<type>::block_size;
+    constexpr auto length_size = sizeof(Word) * 2;
+
+    block += '\x80';
+    block.resize((block.size() + length_size + block_size - 1) / block_size *
+                     block_size,
+                 '\0');
+    const uint64_t bits = length << 3;
+    for (size_t i = 0; i < 8; ++i)
+        block[block.size() - 1 - i] = bits >> (i * 8);
+    if constexpr (length_size > 8)
+        block[block.size() - 9] = length >> 61;
+    compress<type>(state, block.data(), block.size() / block_size);
+    block.clear();
+
+    ret.reserve(Sha2Common<type>::digest_size);
+    for (const Word word : state)
+        for (size_t i = sizeof(Word); i > 0; --i)
+            ret += static_cast<char>(word >> ((i - 1) * 8));
+
+    return ret;
+}
+
+template <DigestType type>
+void Sha2<type>::reset() {
+    state = Sha2Common<type>::initial;
+    block.clear();
+    length = 0;
+}
+
+template class Sha2<DigestType::Sha256>;
+template class Sha2<DigestType::Sha512>;
+
+}  // namespace textencode
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <textencode/common.hpp>
+#include <type_traits>
+
+namespace textencode {
+
+// Hashes the data passed through process(), emitting only the raw digest
+// bytes from complete(). A partial block is kept in the given resource.
+template <DigestType type>
+class Sha2 : public Converter {
+  public:
+    explicit Sha2(std::pmr::memory_resource* resource =
+                      std::pmr::get_default_resource());
+
+    std::string process(std::string_view data) override;
+    std::pmr::string process(std::string_view data,
+                             std::pmr::memory_resource* resource) override;
+    std::string complete() override;
+    std::pmr::string complete(std::pmr::memory_resource* resource) override;
+    void reset() override;
+
+  private:
+    using Word = std::conditional_t<type == DigestType::Sha256, uint32_t,
+                                    uint64_t>;
+
+    std::array<Word, 8> state;
+    std::pmr::string block;
+    uint64_t length = 0;
+
+    template <typename String>
+    String completeAs(String ret);
+};
+
+using Sha256 = Sha2<DigestType::Sha256>;
+using Sha512 = Sha2<DigestType::Sha512>;
+
+}  // namespace textencode
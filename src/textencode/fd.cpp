@@ -1,45 +1,262 @@
+#include <sys/stat.h>
 #include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <set>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <system_error>
+#include <textencode/alphabet.hpp>
 #include <textencode/fd.hpp>
+#include <textencode/hash.hpp>
+#include <textencode/internal/fd.hpp>
+#include <textencode/internal/state.hpp>
+#include <textencode/lines.hpp>
 #include <textencode/map.hpp>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace textencode {
 
 namespace {
 
-std::string read(int fd, size_t size) {
-    std::string buffer(size, '\0');
-    ssize_t ret = ::read(fd, buffer.data(), buffer.size());
-    if (ret < 0)
-        throw std::system_error(errno, std::generic_category(),
-                                "Failed to read data");
-    buffer.resize(ret);
-    return buffer;
-}
+using internal::read;
+using internal::readAppend;
+using internal::write;
+
+class Sink {
+  public:
+    explicit Sink(const Output& output) : fd(output.fd) {
+        if (output.alphabet)
+            encoder.reset(new ToCustomBaseN(*output.alphabet));
+        else
+            encoder = acquire(to_binary, output.type);
+        if (output.digest)
+            digest = digests.at(*output.digest)();
+    }
+
+    void process(std::string_view data) {
+        if (digest)
+            write(fd, encoder->process(digest->process(data)));
+        else
+            write(fd, encoder->process(data));
+    }
+
+    void complete() {
+        if (digest)
+            write(fd, encoder->process(digest->complete()));
+        write(fd, encoder->complete());
+    }
+
+  private:
+    int fd;
+    PooledConverter encoder;
+    std::unique_ptr<Converter> digest;
+};
 
-void write(int fd, std::string_view data) {
-    ssize_t ret = ::write(fd, data.data(), data.size());
-    if (ret < 0)
-        throw std::system_error(errno, std::generic_category(),
-                                "Failed to write data");
-    if (static_cast<size_t>(ret) != data.size())
-        throw std::runtime_error("Failed to write data");
+void transcode(int fd_in, Converter& from_func,
+               const std::vector<Output>& outputs) {
+    std::vector<Sink> sinks(outputs.begin(), outputs.end());
+
+    std::string data;
+    while (data = read(fd_in, 4096), data.size() > 0) {
+        const std::string decoded = from_func.process(data);
+        for (auto& sink : sinks)
+            sink.process(decoded);
+    }
+
+    const std::string decoded = from_func.complete();
+    for (auto& sink : sinks) {
+        sink.process(decoded);
+        sink.complete();
+    }
 }
 
 }  // namespace
 
 void transcode(int fd_in, EncodingType from, int fd_out, EncodingType to) {
-    auto from_func = from_binary.at(from)();
-    auto to_func = to_binary.at(to)();
+    transcode(fd_in, from, {{fd_out, to}});
+}
 
-    std::string data;
-    while (data = read(fd_in, 4096), data.size() > 0)
-        write(fd_out, to_func->process(from_func->process(data)));
+void transcode(int fd_in, EncodingType from,
+               const std::vector<Output>& outputs) {
+    transcode(fd_in, *acquire(from_binary, from), outputs);
+}
+
+void transcode(int fd_in, std::unique_ptr<Converter> from_func,
+               const std::vector<Output>& outputs) {
+    transcode(fd_in, *from_func, outputs);
+}
+
+std::string Checkpoint::serialize() const {
+    std::string ret;
+    internal::saveNumber(ret, offset);
+    internal::saveNumber(ret, from_state.size());
+    ret += from_state;
+    internal::saveNumber(ret, to_state.size());
+    ret += to_state;
+    return ret;
+}
+
+Checkpoint Checkpoint::parse(std::string_view data) {
+    Checkpoint ret;
+    ret.offset = internal::loadNumber(data, UINT64_MAX);
+    for (auto* state : {&ret.from_state, &ret.to_state}) {
+        // Checked once the length itself has been taken off data
+        const uint64_t size = internal::loadNumber(data, UINT64_MAX);
+        if (size > data.size())
+            throw std::invalid_argument("Truncated converter state");
+        *state = data.substr(0, size);
+        data.remove_prefix(size);
+    }
+    internal::checkStateEnd(data);
+    return ret;
+}
+
+Checkpoint transcodeRange(int fd_in, EncodingType from, int fd_out,
+                          EncodingType to, const Checkpoint& start,
+                          std::optional<uint64_t> end, bool complete) {
+    constexpr size_t buffer_size = 1 << 16;
+    auto decoder = acquire(from_binary, from);
+    auto encoder = acquire(to_binary, to);
+    if (!start.from_state.empty())
+        decoder->restore(start.from_state);
+    if (!start.to_state.empty())
+        encoder->restore(start.to_state);
+
+    std::string buffer;
+    uint64_t offset = start.offset;
+    while (!end || offset < *end) {
+        buffer.resize(end ? std::min<uint64_t>(buffer_size, *end - offset)
+                          : buffer_size);
+        const ssize_t ret =
+            pread(fd_in, buffer.data(), buffer.size(), offset);
+        if (ret < 0)
+            throw std::system_error(errno, std::generic_category(),
+                                    "Failed to read data");
+        if (ret == 0)
+            break;
+        buffer.resize(ret);
+        offset += ret;
+        write(fd_out, encoder->process(decoder->process(buffer)));
+    }
+
+    if (!end || complete) {
+        write(fd_out, encoder->process(decoder->complete()));
+        write(fd_out, encoder->complete());
+    }
+    return {offset, decoder->snapshot(), encoder->snapshot()};
+}
+
+void transcodeLines(int fd_in, EncodingType from, int fd_out, EncodingType to,
+                    size_t threads) {
+    constexpr size_t batch_size = 1 << 20;
+    threads = std::max<size_t>(threads, 1);
+
+    std::string pending;
+    std::vector<std::string> outs(threads);
+    std::vector<std::exception_ptr> errors(threads);
+    std::vector<std::thread> workers;
+    size_t line = 1;
+
+    for (bool more = true; more || !pending.empty();) {
+        while (more && pending.size() < batch_size * threads)
+            more = readAppend(fd_in, pending, batch_size);
+
+        // Only whole lines are converted until the input is exhausted
+        size_t end = pending.size();
+        if (more) {
+            end = pending.rfind('\n') + 1;
+            if (end == 0) {
+                more = readAppend(fd_in, pending, batch_size);
+                continue;
+            }
+        }
+        const std::string_view batch(pending.data(), end);
+
+        size_t begin = 0;
+        for (size_t i = 0; i < threads; ++i) {
+            size_t split = batch.size();
+            if (i + 1 < threads) {
+                const size_t pos =
+                    batch.find('\n', begin + batch.size() / threads);
+                if (pos != std::string_view::npos)
+                    split = pos + 1;
+            }
+            const std::string_view slice = batch.substr(begin, split - begin);
+            const size_t first_line = line;
+            line += std::count(slice.begin(), slice.end(), '\n');
+            begin = split;
+
+            auto work = [&, i, slice, first_line]() {
+                try {
+                    convertLines(slice, from, to, outs[i], first_line);
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            };
+            if (i + 1 < threads)
+                workers.emplace_back(work);
+            else
+                work();
+        }
+        for (auto& worker : workers)
+            worker.join();
+        workers.clear();
+
+        for (size_t i = 0; i < threads; ++i) {
+            if (errors[i])
+                std::rethrow_exception(errors[i]);
+            write(fd_out, outs[i]);
+            outs[i].clear();
+        }
+        pending.erase(0, end);
+    }
+}
+
+void transcodeHashes(int fd_in, int fd_out, HashFormat to, bool prefix,
+                     std::optional<DigestType> type) {
+    constexpr size_t batch_size = 1 << 20;
+
+    // Both buffers are reused, so steady state batches don't allocate
+    std::string pending, out;
+    size_t line = 1;
+    for (bool more = true; more || !pending.empty();) {
+        more = more && readAppend(fd_in, pending, batch_size);
+
+        size_t end = pending.size();
+        if (more) {
+            end = pending.rfind('\n') + 1;
+            if (end == 0)
+                continue;
+        }
+        const std::string_view batch(pending.data(), end);
+
+        convertHashes(batch, to, out, prefix, type, line);
+        line += std::count(batch.begin(), batch.end(), '\n');
+        write(fd_out, out);
+        out.clear();
+        pending.erase(0, end);
+    }
+}
 
-    write(fd_out, to_func->process(from_func->complete()));
-    write(fd_out, to_func->complete());
+void checkDistinctFiles(const std::vector<std::string>& paths) {
+    std::set<std::string> names;
+    std::set<std::pair<dev_t, ino_t>> files;
+    for (const auto& path : paths) {
+        struct stat st;
+        if (!names.insert(path).second ||
+            (stat(path.c_str(), &st) == 0 &&
+             !files.insert({st.st_dev, st.st_ino}).second))
+            throw std::invalid_argument(path + " is given more than once");
+    }
 }
 
 }  // namespace textencode
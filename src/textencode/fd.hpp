@@ -1,9 +1,73 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <textencode/alphabet.hpp>
 #include <textencode/common.hpp>
+#include <textencode/hash.hpp>
+#include <vector>
 
 namespace textencode {
 
+struct Output {
+    int fd;
+    EncodingType type;
+    // Writes only the encoded digest of the decoded data when set
+    std::optional<DigestType> digest = std::nullopt;
+    // Encodes with this alphabet in place of type when set
+    std::optional<Alphabet> alphabet = std::nullopt;
+};
+
 void transcode(int fd_in, EncodingType from, int fd_out, EncodingType to);
 
+// Decodes the input once and feeds every chunk to each output's encoder
+void transcode(int fd_in, EncodingType from,
+               const std::vector<Output>& outputs);
+void transcode(int fd_in, std::unique_ptr<Converter> from,
+               const std::vector<Output>& outputs);
+
+// Where a ranged transcode stopped, from which the rest of the input can be
+// converted later or by another process
+struct Checkpoint {
+    // The input offset to carry on from
+    uint64_t offset = 0;
+    // Converter::snapshot() of the decoder and encoder, empty for fresh ones
+    std::string from_state;
+    std::string to_state;
+
+    // A compact blob holding the checkpoint, and back. parse() throws
+    // std::invalid_argument for anything serialize() didn't write.
+    std::string serialize() const;
+    static Checkpoint parse(std::string_view data);
+};
+
+// Converts the input from start.offset up to end with converters restored
+// from start, returning where it stopped. Without an end, or with complete
+// set, the conversion is also completed, as for independent pieces. fd_in is
+// read with pread(), so it has to be seekable, and the output is appended to
+// fd_out.
+Checkpoint transcodeRange(int fd_in, EncodingType from, int fd_out,
+                          EncodingType to, const Checkpoint& start = {},
+                          std::optional<uint64_t> end = std::nullopt,
+                          bool complete = false);
+
+// Converts each input line as an independent record, see convertLines().
+// Batches are split across the given number of threads, preserving order.
+void transcodeLines(int fd_in, EncodingType from, int fd_out, EncodingType to,
+                    size_t threads = 1);
+
+// Throws std::invalid_argument when two paths name the same file, either
+// as the same string or, for files that already exist, by device and inode.
+// Outputs are checked with this before any is opened, since two opens of one
+// file would overwrite each other.
+void checkDistinctFiles(const std::vector<std::string>& paths);
+
+// Rewrites each input line's hash in the given format, see convertHashes()
+void transcodeHashes(int fd_in, int fd_out, HashFormat to, bool prefix = false,
+                     std::optional<DigestType> type = std::nullopt);
+
 }  // namespace textencode
@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <textencode/base_n.hpp>
+#include <textencode/common.hpp>
+#include <textencode/hash.hpp>
+#include <textencode/internal/base_n.hpp>
+#include <textencode/internal/nix.hpp>
+#include <textencode/nix.hpp>
+
+namespace textencode {
+
+namespace {
+
+struct DigestInfo {
+    DigestType type;
+    std::string_view name;
+    size_t size;
+};
+
+constexpr std::array<DigestInfo, 2> digest_infos = {{
+    {DigestType::Sha256, "sha256", 32},
+    {DigestType::Sha512, "sha512", 64},
+}};
+
+// Long enough for the hex form of the largest digest
+constexpr size_t max_symbols = 128;
+
+const DigestInfo& info(DigestType type) {
+    for (const auto& info : digest_infos)
+        if (info.type == type)
+            return info;
+    throw std::invalid_argument("Unknown digest type");
+}
+
+constexpr size_t hexSymbols(size_t size) {
+    return size * 2;
+}
+
+constexpr size_t base64Symbols(size_t size) {
+    return (size + 2) / 3 * 4;
+}
+
+// Decodes symbols as the encoding whose length matches size bytes
+template <typename Decoder>
+void decodeDigest(std::string_view symbols, size_t size, char* out) {
+    char buffer[max_symbols];
+    std::copy(symbols.begin(), symbols.end(), buffer);
+    if (Decoder::decodeInPlace(buffer, symbols.size()) != size)
+        throw std::runtime_error("Invalid hash");
+    std::copy(buffer, buffer + size, out);
+}
+
+}  // namespace
+
+std::string_view Hash::bytes() const {
+    return std::string_view(digest.data(), digestSize(type));
+}
+
+size_t digestSize(DigestType type) {
+    return info(type).size;
+}
+
+std::string_view digestName(DigestType type) {
+    return info(type).name;
+}
+
+Hash parseHash(std::string_view str, std::optional<DigestType> type) {
+    // Neither ':' nor '-' can appear in any of the digest encodings
+    bool sri = false;
+    const size_t pos = str.find_first_of(":-");
+    if (pos != std::string_view::npos) {
+        const auto name = str.substr(0, pos);
+        const auto it =
+            std::find_if(digest_infos.begin(), digest_infos.end(),
+                         [&](const auto& info) { return info.name == name; });
+        if (it == digest_infos.end())
+            throw std::runtime_error("Unknown hash type");
+        if (type && *type != it->type)
+            throw std::runtime_error("Hash type mismatch");
+        type = it->type;
+        sri = str[pos] == '-';
+        str.remove_prefix(pos + 1);
+    }
+
+    for (const auto& info : digest_infos) {
+        if (type && *type != info.type)
+            continue;
+
+        Hash ret{info.type, {}};
+        const size_t size = info.size;
+        if (str.size() == base64Symbols(size))
+            decodeDigest<FromBase64>(str, size, ret.digest.data());
+        else if (sri)
+            continue;
+        else if (str.size() == hexSymbols(size))
+            decodeDigest<FromBase16>(str, size, ret.digest.data());
+        else if (str.size() == internal::nixSymbols(size))
+            decodeDigest<FromNix32>(str, size, ret.digest.data());
+        else
+            continue;
+        return ret;
+    }
+
+    throw std::runtime_error("Invalid hash length");
+}
+
+void appendHash(std::string& out, const Hash& hash, HashFormat format,
+                bool prefix) {
+    const auto& digest = info(hash.type);
+    const std::string_view bytes = hash.bytes();
+
+    size_t symbols = 0;
+    switch (format) {
+        case HashFormat::Base16:
+            symbols = hexSymbols(digest.size);
+            break;
+        case HashFormat::Nix32:
+            symbols = internal::nixSymbols(digest.size);
+            break;
+        case HashFormat::Base64:
+        case HashFormat::Sri:
+            symbols = base64Symbols(digest.size);
+            break;
+    }
+    prefix = prefix || format == HashFormat::Sri;
+
+    // Growing in place keeps a reused out free of allocations
+    const size_t offset = out.size();
+    out.resize(offset + (prefix ? digest.name.size() + 1 : 0) + symbols);
+    char* pos = out.data() + offset;
+    if (prefix) {
+        pos = std::copy(digest.name.begin(), digest.name.end(), pos);
+        *pos++ = format == HashFormat::Sri ? '-' : ':';
+    }
+
+    switch (format) {
+        case HashFormat::Base16:
+            internal::encodeQuanta<EncodingType::Base16>(bytes.data(),
+                                                         bytes.size(), pos);
+            for (char* c = pos; c != pos + symbols; ++c)
+                if (*c >= 'A')
+                    *c += 'a' - 'A';
+            break;
+        case HashFormat::Nix32:
+            internal::toSymbols(bytes, pos);
+            break;
+        case HashFormat::Base64:
+        case HashFormat::Sri: {
+            const size_t quanta = bytes.size() / 3;
+            const size_t tail = bytes.size() % 3;
+            internal::encodeQuanta<EncodingType::Base64>(bytes.data(), quanta,
+                                                         pos);
+            if (tail > 0) {
+                char last[3] = {};
+                std::copy(bytes.end() - tail, bytes.end(), last);
+                internal::encodeQuanta<EncodingType::Base64>(last, 1,
+                                                             pos + quanta * 4);
+                std::fill(pos + symbols - (3 - tail), pos + symbols, '=');
+            }
+            break;
+        }
+    }
+}
+
+std::string formatHash(const Hash& hash, HashFormat format, bool prefix) {
+    std::string ret;
+    appendHash(ret, hash, format, prefix);
+    return ret;
+}
+
+void convertHashes(std::string_view data, HashFormat to, std::string& out,
+                   bool prefix, std::optional<DigestType> type,
+                   size_t first_line) {
+    for (size_t line = first_line; !data.empty(); ++line) {
+        const size_t end = data.find('\n');
+        std::string_view record = data.substr(0, end);
+        data.remove_prefix(end == std::string_view::npos ? data.size()
+                                                         : end + 1);
+        if (!record.empty() && record.back() == '\r')
+            record.remove_suffix(1);
+
+        try {
+            if (!record.empty())
+                appendHash(out, parseHash(record, type), to, prefix);
+            out += '\n';
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error("Line " + std::to_string(line) + ": " +
+                                     e.what());
+        }
+    }
+}
+
+}  // namespace textencode
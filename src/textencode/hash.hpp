@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <textencode/common.hpp>
+
+namespace textencode {
+
+// Text forms of a hash, as used by nix. Base16 is lowercase, and only Sri
+// always carries the TYPE- prefix.
+enum class HashFormat {
+    Base16,
+    Nix32,
+    Base64,
+    Sri,
+};
+
+// A digest held inline, so parsing and formatting don't allocate
+struct Hash {
+    DigestType type;
+    std::array<char, 64> digest;
+
+    std::string_view bytes() const;
+};
+
+size_t digestSize(DigestType type);
+std::string_view digestName(DigestType type);
+
+// Parses TYPE:DIGEST, the SRI form TYPE-BASE64, or a bare DIGEST. The
+// encoding of the digest is inferred from its length. A bare digest takes
+// the given type, or the one implied by its length when none is given.
+Hash parseHash(std::string_view str,
+               std::optional<DigestType> type = std::nullopt);
+
+// Appends hash in the given format, prefixed with TYPE: if requested
+void appendHash(std::string& out, const Hash& hash, HashFormat format,
+                bool prefix = false);
+std::string formatHash(const Hash& hash, HashFormat format,
+                       bool prefix = false);
+
+// Rewrites each newline delimited hash of data in the given format,
+// appending the results to out followed by a newline. Empty lines are kept,
+// and the CR of CRLF line endings is dropped.
+// Errors name the failing line, counting from first_line.
+void convertHashes(std::string_view data, HashFormat to, std::string& out,
+                   bool prefix = false,
+                   std::optional<DigestType> type = std::nullopt,
+                   size_t first_line = 1);
+
+}  // namespace textencode
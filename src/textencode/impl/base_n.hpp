@@ -0,0 +1,243 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <textencode/base_n.hpp>
+#include <textencode/common.hpp>
+#include <textencode/internal/base_n.hpp>
+#include <textencode/internal/common.hpp>
+#include <textencode/internal/state.hpp>
+
+// Member definitions of ToBaseN and FromBaseN, included by base_n.hpp in
+// header-only builds
+namespace textencode {
+inline namespace TEXTENCODE_MODE {
+
+template <EncodingType type>
+std::string ToBaseN<type>::process(std::string_view data) {
+    return processAs(data, std::string());
+}
+
+template <EncodingType type>
+std::pmr::string ToBaseN<type>::process(std::string_view data,
+                                        std::pmr::memory_resource* resource) {
+    return processAs(data, std::pmr::string(resource));
+}
+
+template <EncodingType type>
+std::string ToBaseN<type>::complete() {
+    return completeAs(std::string());
+}
+
+template <EncodingType type>
+std::pmr::string ToBaseN<type>::complete(
+    std::pmr::memory_resource* resource) {
+    return completeAs(std::pmr::string(resource));
+}
+
+template <EncodingType type>
+template <typename String>
+String ToBaseN<type>::processAs(std::string_view data, String ret) {
+    constexpr auto quantum_bits = internal::Common<type>::quantum_bits;
+    static_assert(quantum_bits < sizeof(decltype(buffer)) * 8);
+
+    // Only whole quanta are written, the last held back until more arrives
+    ret.reserve((num_bits / 8 + data.size()) / (quantum_bits / 8) *
+                internal::Common<type>::quantum_symbols);
+
+    for (const auto byte : data) {
+        if (num_bits == quantum_bits)
+            flushBuffer(ret);
+        buffer = (buffer << 8) | (byte & 0xff);
+        num_bits += 8;
+    }
+
+    return ret;
+}
+
+template <EncodingType type>
+template <typename String>
+String ToBaseN<type>::completeAs(String ret) {
+    if (num_bits == 0)
+        return ret;
+
+    ret.reserve(internal::Common<type>::quantum_symbols);
+
+    flushBuffer(ret);
+    if (num_bits > 0)
+        ret += toSymbol(buffer << (internal::Common<type>::shift - num_bits));
+    ret.resize(internal::Common<type>::quantum_symbols, '=');
+
+    return ret;
+}
+
+template <EncodingType type>
+std::string ToBaseN<type>::snapshot() const {
+    std::string ret;
+    internal::saveNumber(ret, num_bits);
+    internal::saveNumber(ret, internal::lowBits(buffer, num_bits));
+    return ret;
+}
+
+template <EncodingType type>
+void ToBaseN<type>::restore(std::string_view state) {
+    // Whole bytes are buffered, up to a quantum
+    num_bits = internal::loadNumber(
+        state, internal::Common<type>::quantum_bits, 8);
+    buffer = internal::loadNumber(state, internal::lowBits(~0, num_bits));
+    internal::checkStateEnd(state);
+}
+
+template <EncodingType type>
+void ToBaseN<type>::reset() {
+    buffer = 0;
+    num_bits = 0;
+}
+
+template <EncodingType type>
+template <typename String>
+void ToBaseN<type>::flushBuffer(String& out) {
+    constexpr auto shift = internal::Common<type>::shift;
+    for (; num_bits >= shift; num_bits -= shift)
+        out += toSymbol(buffer >> (num_bits - shift));
+}
+
+template <EncodingType type>
+char ToBaseN<type>::toSymbol(char byte) {
+    constexpr auto& symbols = internal::Common<type>::symbols;
+    return symbols[byte & (symbols.size() - 1)];
+}
+
+template <EncodingType type>
+std::string FromBaseN<type>::process(std::string_view data) {
+    return processAs(data, std::string());
+}
+
+template <EncodingType type>
+std::pmr::string FromBaseN<type>::process(
+    std::string_view data, std::pmr::memory_resource* resource) {
+    return processAs(data, std::pmr::string(resource));
+}
+
+template <EncodingType type>
+std::string FromBaseN<type>::complete() {
+    return completeAs(std::string());
+}
+
+template <EncodingType type>
+std::pmr::string FromBaseN<type>::complete(
+    std::pmr::memory_resource* resource) {
+    return completeAs(std::pmr::string(resource));
+}
+
+template <EncodingType type>
+template <typename String>
+String FromBaseN<type>::processAs(std::string_view data, String ret) {
+    constexpr auto quantum_bits = internal::Common<type>::quantum_bits;
+    ret.resize(data.size() + quantum_bits / 8);
+    ret.resize(decode(data, ret.data()) - ret.data());
+    return ret;
+}
+
+template <EncodingType type>
+template <typename String>
+String FromBaseN<type>::completeAs(String ret) {
+    ret.resize(num_bits >> 3);
+    ret.resize(finish(ret.data()) - ret.data());
+    return ret;
+}
+
+template <EncodingType type>
+std::string FromBaseN<type>::snapshot() const {
+    std::string ret;
+    internal::saveNumber(ret, num_bits);
+    internal::saveNumber(ret, padding_bits);
+    internal::saveNumber(ret, internal::lowBits(buffer, num_bits));
+    return ret;
+}
+
+template <EncodingType type>
+void FromBaseN<type>::restore(std::string_view state) {
+    constexpr auto shift = internal::Common<type>::shift;
+    num_bits = internal::loadNumber(
+        state, internal::Common<type>::quantum_bits, shift);
+    padding_bits = internal::loadNumber(state, UINT8_MAX, shift);
+    buffer = internal::loadNumber(state, internal::lowBits(~0, num_bits));
+    internal::checkStateEnd(state);
+}
+
+template <EncodingType type>
+void FromBaseN<type>::reset() {
+    buffer = 0;
+    num_bits = 0;
+    padding_bits = 0;
+}
+
+template <EncodingType type>
+size_t FromBaseN<type>::decodeInPlace(char* data, size_t size) {
+    // Every byte takes at least two symbols, so out never passes the input
+    FromBaseN decoder;
+    char* out = decoder.decode(std::string_view(data, size), data);
+    return decoder.finish(out) - data;
+}
+
+template <EncodingType type>
+char* FromBaseN<type>::decode(std::string_view data, char* out) {
+    constexpr auto shift = internal::Common<type>::shift;
+    constexpr auto quantum_bits = internal::Common<type>::quantum_bits;
+    static_assert(quantum_bits < sizeof(decltype(buffer)) * 8);
+
+    for (const char symbol : data) {
+        const char byte =
+            internal::Common<type>::inverse[static_cast<unsigned char>(symbol)];
+        if (byte == static_cast<char>(internal::CharCodes::Ignore))
+            continue;
+        if (byte == static_cast<char>(internal::CharCodes::Padding)) {
+            padding_bits += shift;
+            continue;
+        }
+        if (padding_bits > 0)
+            throw std::runtime_error("Invalid padding");
+        if (!internal::Common<type>::validByte(byte))
+            throw std::runtime_error("Invalid symbol");
+
+        if (num_bits == quantum_bits)
+            out = flushBuffer(out);
+        buffer = (buffer << shift) | byte;
+        num_bits += shift;
+    }
+
+    return out;
+}
+
+template <EncodingType type>
+char* FromBaseN<type>::finish(char* out) {
+    constexpr auto quantum_bits = internal::Common<type>::quantum_bits;
+    if (padding_bits >= quantum_bits)
+        throw std::runtime_error("Too much padding");
+    if ((num_bits + padding_bits) % quantum_bits != 0)
+        throw std::runtime_error("Bad input width");
+    const int zero_mask = (1 << (num_bits % 8)) - 1;
+    if (buffer & zero_mask)
+        throw std::runtime_error("Bad encoding");
+
+    out = flushBuffer(out);
+    if (num_bits >= internal::Common<type>::shift)
+        throw std::runtime_error("Invalid padding");
+
+    return out;
+}
+
+template <EncodingType type>
+char* FromBaseN<type>::flushBuffer(char* out) {
+    for (; num_bits >= 8; num_bits -= 8)
+        *out++ = buffer >> (num_bits - 8);
+    return out;
+}
+
+}  // namespace TEXTENCODE_MODE
+}  // namespace textencode
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <textencode/common.hpp>
+#include <textencode/internal/common.hpp>
+#include <textencode/internal/nix.hpp>
+#include <textencode/internal/utils.hpp>
+#include <textencode/nix.hpp>
+#include <type_traits>
+#include <utility>
+
+// Definitions of ToNix32 and FromNix32, included by nix.hpp in header-only
+// builds
+namespace textencode {
+
+namespace internal {
+inline namespace TEXTENCODE_MODE {
+
+using NixCommon = Common<EncodingType::Nix32>;
+
+// Writes the value of every symbol to out, which may alias data
+TEXTENCODE_INLINE char* toValues(std::string_view data, char* out) {
+    for (const char symbol : data) {
+        const char byte =
+            NixCommon::inverse[static_cast<unsigned char>(symbol)];
+        if (byte == static_cast<char>(CharCodes::Ignore))
+            continue;
+        if (!NixCommon::validByte(byte))
+            throw std::runtime_error("Invalid symbol");
+
+        *out++ = byte;
+    }
+
+    return out;
+}
+
+// Decodes symbol values into bytes over the front of the same buffer
+TEXTENCODE_INLINE size_t fromValues(char* values, size_t size) {
+    if ((size + 7) * 5 / 8 == (size + 8) * 5 / 8)
+        throw std::runtime_error("Invalid nix32 length");
+    const size_t num_zeroes = size * 5 % 8;
+    const int zero_mask = ((1 << num_zeroes) - 1) << (5 - num_zeroes);
+    if (size > 0 && (values[0] & zero_mask))
+        throw std::runtime_error("Invalid nix32 hash");
+
+    // Once the least significant symbol comes first, byte i only depends on
+    // symbols from i onwards and can be written in place
+    std::reverse(values, values + size);
+    const size_t ret = size * 5 / 8;
+    for (size_t i = 0; i < ret; ++i) {
+        const size_t bit_offset = i * 8;
+        size_t symbol = bit_offset / 5;
+        int byte = (values[symbol] & 0xff) >> (bit_offset % 5);
+        for (int shift = 5 - bit_offset % 5; shift < 8; shift += 5)
+            if (++symbol < size)
+                byte |= values[symbol] << shift;
+        values[i] = byte;
+    }
+
+    return ret;
+}
+
+}  // namespace TEXTENCODE_MODE
+}  // namespace internal
+
+inline namespace TEXTENCODE_MODE {
+
+TEXTENCODE_INLINE ToNix32::ToNix32(std::pmr::memory_resource* resource)
+    : input(resource) {
+}
+
+TEXTENCODE_INLINE std::string ToNix32::process(std::string_view data) {
+    input += data;
+    return {};
+}
+
+TEXTENCODE_INLINE std::pmr::string ToNix32::process(
+    std::string_view data, std::pmr::memory_resource* resource) {
+    input += data;
+    return std::pmr::string(resource);
+}
+
+TEXTENCODE_INLINE std::string ToNix32::complete() {
+    return completeAs(std::string());
+}
+
+TEXTENCODE_INLINE std::pmr::string ToNix32::complete(
+    std::pmr::memory_resource* resource) {
+    return completeAs(std::pmr::string(resource));
+}
+
+template <typename String>
+String ToNix32::completeAs(String ret) {
+    ret.resize(internal::nixSymbols(input.size()));
+    internal::toSymbols(input, ret.data());
+    input.clear();
+    return ret;
+}
+
+TEXTENCODE_INLINE std::string ToNix32::snapshot() const {
+    return std::string(input);
+}
+
+TEXTENCODE_INLINE void ToNix32::restore(std::string_view state) {
+    input = state;
+}
+
+TEXTENCODE_INLINE void ToNix32::reset() {
+    internal::clearBuffer(input);
+}
+
+TEXTENCODE_INLINE FromNix32::FromNix32(std::pmr::memory_resource* resource)
+    : input(resource) {
+}
+
+TEXTENCODE_INLINE std::string FromNix32::process(std::string_view data) {
+    const size_t offset = input.size();
+    input.resize(offset + data.size());
+    char* const end = internal::toValues(data, input.data() + offset);
+    input.resize(end - input.data());
+    return {};
+}
+
+TEXTENCODE_INLINE std::pmr::string FromNix32::process(
+    std::string_view data, std::pmr::memory_resource* resource) {
+    process(data);
+    return std::pmr::string(resource);
+}
+
+TEXTENCODE_INLINE std::string FromNix32::complete() {
+    return completeAs(std::string());
+}
+
+TEXTENCODE_INLINE std::pmr::string FromNix32::complete(
+    std::pmr::memory_resource* resource) {
+    return completeAs(std::pmr::string(resource));
+}
+
+// The values are decoded over their own front. A std::pmr::string on the
+// converter's resource takes over the buffer. Any other string can't adopt
+// memory from the resource, so the bytes are copied out and the buffer
+// stays with the converter for reuse.
+template <typename String>
+String FromNix32::completeAs(String ret) {
+    input.resize(internal::fromValues(input.data(), input.size()));
+    if constexpr (std::is_same_v<String, std::pmr::string>) {
+        if (ret.get_allocator() == input.get_allocator()) {
+            ret = std::move(input);
+            input.clear();
+            return ret;
+        }
+    }
+    ret.assign(input);
+    input.clear();
+    return ret;
+}
+
+TEXTENCODE_INLINE std::string FromNix32::snapshot() const {
+    return std::string(input);
+}
+
+TEXTENCODE_INLINE void FromNix32::restore(std::string_view state) {
+    for (const char value : state)
+        if (!internal::NixCommon::validByte(value))
+            throw std::invalid_argument("Invalid converter state");
+    input = state;
+}
+
+TEXTENCODE_INLINE void FromNix32::reset() {
+    internal::clearBuffer(input);
+}
+
+TEXTENCODE_INLINE size_t FromNix32::decodeInPlace(char* data, size_t size) {
+    char* const end = internal::toValues(std::string_view(data, size), data);
+    return internal::fromValues(data, end - data);
+}
+
+}  // namespace TEXTENCODE_MODE
+}  // namespace textencode
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <textencode/internal/common.hpp>
+
+namespace textencode::internal {
+
+// The Bitcoin alphabet, leaving out 0, O, I and l
+inline constexpr std::string_view base58_symbols =
+    "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+// Unlike makeInverse() there is no case folding or padding
+inline constexpr auto base58_inverse = []() {
+    std::array<char, 256> ret{};
+    for (size_t i = 0; i < ret.size(); ++i)
+        ret[i] = static_cast<char>(CharCodes::Invalid);
+    for (size_t i = 0; i < base58_symbols.size(); ++i)
+        ret[static_cast<unsigned char>(base58_symbols[i])] = i;
+    ret[' '] = static_cast<char>(CharCodes::Ignore);
+    ret['\r'] = static_cast<char>(CharCodes::Ignore);
+    ret['\n'] = static_cast<char>(CharCodes::Ignore);
+    return ret;
+}();
+
+}  // namespace textencode::internal
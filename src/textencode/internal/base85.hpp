@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <textencode/common.hpp>
+#include <textencode/internal/common.hpp>
+
+namespace textencode::internal {
+
+template <EncodingType type>
+class Base85Properties {};
+
+template <>
+class Base85Properties<EncodingType::Ascii85> {
+  public:
+    // '!' to 'u'
+    static constexpr auto symbols = []() {
+        std::array<char, 85> ret{};
+        for (size_t i = 0; i < ret.size(); ++i)
+            ret[i] = '!' + i;
+        return ret;
+    }();
+    // 'z' stands for a whole word of zeroes
+    static constexpr bool zero_word = true;
+};
+
+template <>
+class Base85Properties<EncodingType::Z85> {
+  public:
+    static constexpr std::array<char, 85> symbols = {
+        '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c',
+        'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 'p',
+        'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z', 'A', 'B', 'C',
+        'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O', 'P',
+        'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', '.', '-', ':',
+        '+', '=', '^', '!', '/', '*', '?', '&', '<', '>', '(', ')', '[',
+        ']', '{', '}', '@', '%', '$', '#',
+    };
+    static constexpr bool zero_word = false;
+};
+
+// Radix 85 packs a fractional number of bits into each symbol, so rather
+// than Common's bit shifting every 4 byte word is a 5 digit number
+template <EncodingType type>
+class Base85Common : public Base85Properties<type> {
+  public:
+    static constexpr size_t word_bytes = 4;
+    static constexpr size_t word_symbols = 5;
+
+    static constexpr auto inverse = []() {
+        std::array<char, 256> ret{};
+        for (size_t i = 0; i < ret.size(); ++i)
+            ret[i] = static_cast<char>(CharCodes::Invalid);
+
+        for (size_t i = 0; i < Base85Common::symbols.size(); ++i)
+            ret[static_cast<unsigned char>(Base85Common::symbols[i])] = i;
+
+        assert(ret[' '] == static_cast<char>(CharCodes::Invalid));
+        ret[' '] = static_cast<char>(CharCodes::Ignore);
+        assert(ret['\r'] == static_cast<char>(CharCodes::Invalid));
+        ret['\r'] = static_cast<char>(CharCodes::Ignore);
+        assert(ret['\n'] == static_cast<char>(CharCodes::Invalid));
+        ret['\n'] = static_cast<char>(CharCodes::Ignore);
+
+        return ret;
+    }();
+};
+
+inline uint32_t loadWord(const char* in) {
+    uint32_t ret = 0;
+    for (size_t i = 0; i < 4; ++i)
+        ret = (ret << 8) | (in[i] & 0xff);
+    return ret;
+}
+
+inline char* storeWord(uint32_t word, char* out) {
+    for (size_t i = 4; i > 0; --i)
+        *out++ = word >> ((i - 1) * 8);
+    return out;
+}
+
+// Encodes whole words with no state carried between calls. The divisors are
+// constant so the compiler turns them into multiplications.
+template <EncodingType type>
+void encodeWords(const char* in, size_t words, char* out) {
+    using Common = Base85Common<type>;
+
+    for (size_t w = 0; w < words; ++w) {
+        uint32_t word = loadWord(in);
+        in += Common::word_bytes;
+        for (size_t i = Common::word_symbols; i > 0; --i) {
+            out[i - 1] = Common::symbols[word % 85];
+            word /= 85;
+        }
+        out += Common::word_symbols;
+    }
+}
+
+// Decodes whole groups up to the first one holding anything but data
+// symbols or overflowing a word, returning how many groups were decoded
+template <EncodingType type>
+size_t decodeWords(const char* in, size_t words, char* out) {
+    using Common = Base85Common<type>;
+
+    for (size_t w = 0; w < words; ++w) {
+        uint64_t value = 0;
+        char seen = 0;
+        for (size_t i = 0; i < Common::word_symbols; ++i) {
+            const char byte =
+                Common::inverse[static_cast<unsigned char>(in[i])];
+            seen |= byte;
+            value = value * 85 + (byte & 0x7f);
+        }
+        if (seen < 0 || value > UINT32_MAX)
+            return w;
+        in += Common::word_symbols;
+        out = storeWord(value, out);
+    }
+    return words;
+}
+
+}  // namespace textencode::internal
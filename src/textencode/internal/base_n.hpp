@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <textencode/common.hpp>
 #include <textencode/internal/common.hpp>
 
@@ -50,4 +51,45 @@ class Properties<EncodingType::Base64> {
     }();
 };
 
+// Encodes whole quanta with no state carried between calls
+template <EncodingType type>
+void encodeQuanta(const char* in, size_t quanta, char* out) {
+    using Common = Common<type>;
+    constexpr size_t quantum_bytes = Common::quantum_bits / 8;
+    constexpr size_t mask = Common::symbols.size() - 1;
+
+    for (size_t q = 0; q < quanta; ++q) {
+        uint64_t buffer = 0;
+        for (size_t i = 0; i < quantum_bytes; ++i)
+            buffer = (buffer << 8) | (*in++ & 0xff);
+        for (size_t i = Common::quantum_symbols; i > 0; --i)
+            *out++ = Common::symbols[(buffer >> ((i - 1) * Common::shift)) &
+                                     mask];
+    }
+}
+
+// Decodes whole quanta up to the first one holding anything but data
+// symbols, returning how many quanta were decoded
+template <EncodingType type>
+size_t decodeQuanta(const char* in, size_t quanta, char* out) {
+    using Common = Common<type>;
+    constexpr size_t quantum_bytes = Common::quantum_bits / 8;
+
+    for (size_t q = 0; q < quanta; ++q) {
+        uint64_t buffer = 0;
+        char seen = 0;
+        for (size_t i = 0; i < Common::quantum_symbols; ++i) {
+            const char byte = Common::inverse[static_cast<unsigned char>(in[i])];
+            seen |= byte;
+            buffer = (buffer << Common::shift) | (byte & 0x3f);
+        }
+        if (!Common::validByte(seen))
+            return q;
+        in += Common::quantum_symbols;
+        for (size_t i = quantum_bytes; i > 0; --i)
+            *out++ = buffer >> ((i - 1) * 8);
+    }
+    return quanta;
+}
+
 }  // namespace textencode::internal
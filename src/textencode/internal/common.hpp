@@ -3,6 +3,7 @@
 #include <array>
 #include <cassert>
 #include <cstddef>
+#include <string_view>
 #include <textencode/common.hpp>
 #include <textencode/internal/utils.hpp>
 
@@ -14,6 +15,35 @@ enum class CharCodes : char {
     Padding = -3,
 };
 
+// Maps each character to its symbol value or a CharCodes entry. Letters
+// missing from the symbols fold to their other case where that's present.
+constexpr std::array<char, 256> makeInverse(std::string_view symbols) {
+    std::array<char, 256> ret{};
+    for (size_t i = 0; i < ret.size(); ++i)
+        ret[i] = static_cast<char>(CharCodes::Invalid);
+
+    for (size_t i = 0; i < symbols.size(); ++i)
+        ret[static_cast<unsigned char>(symbols[i])] = i;
+
+    for (char i = 'A'; i <= 'Z'; ++i)
+        if (ret[i] == static_cast<char>(CharCodes::Invalid))
+            ret[i] = ret[i - 'A' + 'a'];
+    for (char i = 'a'; i <= 'z'; ++i)
+        if (ret[i] == static_cast<char>(CharCodes::Invalid))
+            ret[i] = ret[i - 'a' + 'A'];
+
+    assert(ret[' '] == static_cast<char>(CharCodes::Invalid));
+    ret[' '] = static_cast<char>(CharCodes::Ignore);
+    assert(ret['\r'] == static_cast<char>(CharCodes::Invalid));
+    ret['\r'] = static_cast<char>(CharCodes::Ignore);
+    assert(ret['\n'] == static_cast<char>(CharCodes::Invalid));
+    ret['\n'] = static_cast<char>(CharCodes::Ignore);
+    assert(ret['='] == static_cast<char>(CharCodes::Invalid));
+    ret['='] = static_cast<char>(CharCodes::Padding);
+
+    return ret;
+}
+
 template <EncodingType type>
 class Properties {};
 
@@ -24,35 +54,10 @@ class Common : public Properties<type> {
     static constexpr size_t quantum_bits = lcm(8, shift);
     static constexpr size_t quantum_symbols = quantum_bits / shift;
 
-    static constexpr auto inverse = []() {
-        // Allow use of negatives as sentinel values
-        static_assert(shift < 8);
-
-        std::array<char, 256> ret{};
-        for (size_t i = 0; i < ret.size(); ++i)
-            ret[i] = static_cast<char>(CharCodes::Invalid);
-
-        for (size_t i = 0; i < Common::symbols.size(); ++i)
-            ret[Common::symbols[i]] = i;
-
-        for (char i = 'A'; i <= 'Z'; ++i)
-            if (ret[i] == static_cast<char>(CharCodes::Invalid))
-                ret[i] = ret[i - 'A' + 'a'];
-        for (char i = 'a'; i <= 'z'; ++i)
-            if (ret[i] == static_cast<char>(CharCodes::Invalid))
-                ret[i] = ret[i - 'a' + 'A'];
-
-        assert(ret[' '] == static_cast<char>(CharCodes::Invalid));
-        ret[' '] = static_cast<char>(CharCodes::Ignore);
-        assert(ret['\r'] == static_cast<char>(CharCodes::Invalid));
-        ret['\r'] = static_cast<char>(CharCodes::Ignore);
-        assert(ret['\n'] == static_cast<char>(CharCodes::Invalid));
-        ret['\n'] = static_cast<char>(CharCodes::Ignore);
-        assert(ret['='] == static_cast<char>(CharCodes::Invalid));
-        ret['='] = static_cast<char>(CharCodes::Padding);
-
-        return ret;
-    }();
+    // Allow use of negatives as sentinel values
+    static_assert(shift < 8);
+    static constexpr auto inverse = makeInverse(
+        std::string_view(Common::symbols.data(), Common::symbols.size()));
 
     static constexpr bool validByte(char byte) {
         return (byte & ~((1 << shift) - 1)) == 0;
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <unistd.h>
+#include <cerrno>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace textencode::internal {
+
+inline std::string read(int fd, size_t size) {
+    std::string buffer(size, '\0');
+    ssize_t ret = ::read(fd, buffer.data(), buffer.size());
+    if (ret < 0)
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to read data");
+    buffer.resize(ret);
+    return buffer;
+}
+
+// Reads up to size more bytes onto the end of buffer, returning false on EOF
+inline bool readAppend(int fd, std::string& buffer, size_t size) {
+    const size_t offset = buffer.size();
+    buffer.resize(offset + size);
+    ssize_t ret = ::read(fd, buffer.data() + offset, size);
+    if (ret < 0)
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to read data");
+    buffer.resize(offset + ret);
+    return ret > 0;
+}
+
+inline void write(int fd, std::string_view data) {
+    ssize_t ret = ::write(fd, data.data(), data.size());
+    if (ret < 0)
+        throw std::system_error(errno, std::generic_category(),
+                                "Failed to write data");
+    if (static_cast<size_t>(ret) != data.size())
+        throw std::runtime_error("Failed to write data");
+}
+
+}  // namespace textencode::internal
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+#include <string_view>
 #include <textencode/common.hpp>
 #include <textencode/internal/common.hpp>
 
@@ -17,4 +19,23 @@ class Properties<EncodingType::Nix32> {
     };
 };
 
+constexpr size_t nixSymbols(size_t size) {
+    return (size * 8 + 4) / 5;
+}
+
+// Writes the nixSymbols(data.size()) symbols encoding data to out
+inline void toSymbols(std::string_view data, char* out) {
+    const size_t size = nixSymbols(data.size());
+    for (size_t i = 0; i < size; ++i) {
+        const size_t bit_offset = (size - i - 1) * 5;
+        const size_t byte_offset = bit_offset >> 3;
+        const size_t byte_shift = bit_offset & 0x7;
+        const int upper = data[byte_offset] & 0xff;
+        const int lower =
+            byte_offset + 1 == data.size() ? 0 : data[byte_offset + 1] & 0xff;
+        const char byte = (upper >> byte_shift) | (lower << (8 - byte_shift));
+        out[i] = Common<EncodingType::Nix32>::symbols[byte & 0x1f];
+    }
+}
+
 }  // namespace textencode::internal
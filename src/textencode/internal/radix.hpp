@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Big number radix conversion for encodings like Base58 whose radix isn't a
+// power of two. Numbers are little endian vectors of 64 bit limbs, each below
+// a radix given as a template parameter where 0 stands for 2^64.
+namespace textencode::internal {
+
+__extension__ typedef unsigned __int128 Wide;
+using Limbs = std::vector<uint64_t>;
+
+constexpr size_t karatsuba_limbs = 32;
+
+template <uint64_t radix>
+constexpr Wide limb_base = radix == 0 ? Wide(1) << 64 : Wide(radix);
+
+// Returns value % radix, leaving value / radix behind as the carry
+template <uint64_t radix>
+uint64_t split(Wide& value) {
+    if constexpr (radix == 0) {
+        const uint64_t ret = value;
+        value >>= 64;
+        return ret;
+    } else {
+        const Wide quotient = value / radix;
+        const uint64_t ret = value - quotient * radix;
+        value = quotient;
+        return ret;
+    }
+}
+
+inline void trim(Limbs& a) {
+    while (!a.empty() && a.back() == 0)
+        a.pop_back();
+}
+
+// a = a * mul + add
+template <uint64_t radix>
+void mulAdd(Limbs& a, uint64_t mul, uint64_t add) {
+    Wide carry = add;
+    for (auto& limb : a) {
+        carry += Wide(limb) * mul;
+        limb = split<radix>(carry);
+    }
+    while (carry != 0)
+        a.push_back(split<radix>(carry));
+}
+
+// a += b shifted up by offset limbs
+template <uint64_t radix>
+void addAt(Limbs& a, const uint64_t* b, size_t nb, size_t offset) {
+    if (a.size() < offset + nb)
+        a.resize(offset + nb);
+    Wide carry = 0;
+    for (size_t i = offset; i < offset + nb || carry != 0; ++i) {
+        if (i == a.size())
+            a.push_back(0);
+        carry += a[i];
+        if (i < offset + nb)
+            carry += b[i - offset];
+        a[i] = split<radix>(carry);
+    }
+}
+
+// a -= b, where a >= b
+template <uint64_t radix>
+void subtract(Limbs& a, const Limbs& b) {
+    bool borrow = false;
+    for (size_t i = 0; i < a.size() && (i < b.size() || borrow); ++i) {
+        const Wide sub = Wide(i < b.size() ? b[i] : 0) + borrow;
+        borrow = a[i] < sub;
+        a[i] = borrow ? Wide(a[i]) + limb_base<radix> - sub : a[i] - sub;
+    }
+    trim(a);
+}
+
+template <uint64_t radix>
+Limbs schoolbookMultiply(const uint64_t* a, size_t na, const uint64_t* b,
+                         size_t nb) {
+    Limbs ret(na + nb);
+    for (size_t i = 0; i < na; ++i) {
+        Wide carry = 0;
+        for (size_t j = 0; j < nb; ++j) {
+            carry += Wide(a[i]) * b[j] + ret[i + j];
+            ret[i + j] = split<radix>(carry);
+        }
+        ret[i + nb] = carry;
+    }
+    trim(ret);
+    return ret;
+}
+
+// Karatsuba above karatsuba_limbs, with unbalanced operands cut into
+// balanced products first
+template <uint64_t radix>
+Limbs multiply(const uint64_t* a, size_t na, const uint64_t* b, size_t nb) {
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (nb < karatsuba_limbs)
+        return schoolbookMultiply<radix>(a, na, b, nb);
+
+    if (na >= 2 * nb) {
+        Limbs ret;
+        for (size_t offset = 0; offset < na; offset += nb) {
+            const size_t size = std::min(nb, na - offset);
+            const Limbs part = multiply<radix>(a + offset, size, b, nb);
+            addAt<radix>(ret, part.data(), part.size(), offset);
+        }
+        trim(ret);
+        return ret;
+    }
+
+    const size_t half = na / 2;
+    Limbs low = multiply<radix>(a, half, b, half);
+    const Limbs high =
+        multiply<radix>(a + half, na - half, b + half, nb - half);
+
+    Limbs a_sum(a, a + half), b_sum(b, b + half);
+    addAt<radix>(a_sum, a + half, na - half, 0);
+    addAt<radix>(b_sum, b + half, nb - half, 0);
+    Limbs middle =
+        multiply<radix>(a_sum.data(), a_sum.size(), b_sum.data(), b_sum.size());
+    trim(low);
+    subtract<radix>(middle, low);
+    subtract<radix>(middle, high);
+
+    addAt<radix>(low, middle.data(), middle.size(), half);
+    addAt<radix>(low, high.data(), high.size(), 2 * half);
+    trim(low);
+    return low;
+}
+
+// Converts chunks, most significant first and each below chunk_radix, into
+// limbs. Inputs longer than leaf_chunks are split at precomputed powers of
+// chunk_radix, so the cost follows multiplication rather than growing
+// quadratically.
+template <uint64_t radix>
+class RadixConverter {
+  public:
+    explicit RadixConverter(uint64_t chunk_radix, size_t leaf_chunks = 32)
+        : chunk_radix(chunk_radix), leaf_chunks(leaf_chunks) {
+    }
+
+    Limbs convert(const uint64_t* chunks, size_t size) {
+        if (size <= leaf_chunks) {
+            Limbs ret;
+            for (size_t i = 0; i < size; ++i)
+                mulAdd<radix>(ret, chunk_radix, chunks[i]);
+            return ret;
+        }
+
+        size_t k = 0;
+        while ((leaf_chunks << (k + 1)) < size)
+            k += 1;
+        const size_t low_size = leaf_chunks << k;
+        const Limbs high = convert(chunks, size - low_size);
+        const Limbs low = convert(chunks + size - low_size, low_size);
+        const Limbs& scale = power(k);
+
+        Limbs ret = multiply<radix>(high.data(), high.size(), scale.data(),
+                                    scale.size());
+        addAt<radix>(ret, low.data(), low.size(), 0);
+        trim(ret);
+        return ret;
+    }
+
+  private:
+    uint64_t chunk_radix;
+    size_t leaf_chunks;
+    // chunk_radix^(leaf_chunks << k)
+    std::vector<Limbs> powers;
+
+    const Limbs& power(size_t k) {
+        if (powers.empty()) {
+            Limbs first = {1};
+            for (size_t i = 0; i < leaf_chunks; ++i)
+                mulAdd<radix>(first, chunk_radix, 0);
+            powers.push_back(std::move(first));
+        }
+        while (powers.size() <= k) {
+            const Limbs& last = powers.back();
+            powers.push_back(multiply<radix>(last.data(), last.size(),
+                                             last.data(), last.size()));
+        }
+        return powers[k];
+    }
+};
+
+}  // namespace textencode::internal
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// Converter::snapshot() blobs are a few LEB128 numbers, followed by the
+// input buffered so far for the converters that keep it all
+namespace textencode::internal {
+
+inline void saveNumber(std::string& out, uint64_t value) {
+    for (; value >= 0x80; value >>= 7)
+        out += static_cast<char>(value | 0x80);
+    out += static_cast<char>(value);
+}
+
+// Takes a number off the front of state, which has to be a multiple of step
+// no greater than max
+inline uint64_t loadNumber(std::string_view& state, uint64_t max,
+                           uint64_t step = 1) {
+    uint64_t ret = 0;
+    for (size_t shift = 0;; shift += 7) {
+        if (state.empty() || shift >= 64)
+            throw std::invalid_argument("Truncated converter state");
+        const uint64_t byte = state.front() & 0xff;
+        state.remove_prefix(1);
+        ret |= (byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            break;
+    }
+    if (ret > max || ret % step != 0)
+        throw std::invalid_argument("Invalid converter state");
+    return ret;
+}
+
+inline void checkStateEnd(std::string_view state) {
+    if (!state.empty())
+        throw std::invalid_argument("Trailing data in converter state");
+}
+
+constexpr uint64_t lowBits(uint64_t value, size_t bits) {
+    return value & ((uint64_t(1) << bits) - 1);
+}
+
+}  // namespace textencode::internal
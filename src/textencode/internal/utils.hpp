@@ -14,6 +14,17 @@ constexpr size_t sizeToShift(size_t size) {
     return shift;
 }
 
+// Converter::reset() frees buffers grown past this rather than keeping them
+// for the next use, so pooled converters don't pin large allocations
+constexpr size_t max_kept_capacity = 1 << 20;
+
+template <typename String>
+void clearBuffer(String& buffer) {
+    buffer.clear();
+    if (buffer.capacity() > max_kept_capacity)
+        buffer.shrink_to_fit();
+}
+
 constexpr size_t lcm(size_t a, size_t b) {
     assert(a != 0);
     assert(b != 0);
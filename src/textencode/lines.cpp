@@ -0,0 +1,30 @@
+#include <stdexcept>
+#include <string>
+#include <textencode/lines.hpp>
+#include <textencode/map.hpp>
+
+namespace textencode {
+
+void convertLines(std::string_view data, EncodingType from, EncodingType to,
+                  std::string& out, size_t first_line) {
+    for (size_t line = first_line; !data.empty(); ++line) {
+        const size_t end = data.find('\n');
+        const std::string_view record = data.substr(0, end);
+        data.remove_prefix(end == std::string_view::npos ? data.size()
+                                                         : end + 1);
+
+        try {
+            auto from_func = acquire(from_binary, from);
+            auto to_func = acquire(to_binary, to);
+            out += to_func->process(from_func->process(record));
+            out += to_func->process(from_func->complete());
+            out += to_func->complete();
+            out += '\n';
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error("Line " + std::to_string(line) + ": " +
+                                     e.what());
+        }
+    }
+}
+
+}  // namespace textencode
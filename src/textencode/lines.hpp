@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <textencode/common.hpp>
+
+namespace textencode {
+
+// Converts each newline delimited record of data independently, appending
+// every result to out followed by a newline. The final record need not be
+// newline terminated. Errors name the failing line, counting from first_line.
+void convertLines(std::string_view data, EncodingType from, EncodingType to,
+                  std::string& out, size_t first_line = 1);
+
+}  // namespace textencode
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+#include <textencode/common.hpp>
+#include <textencode/internal/base_n.hpp>
+#include <textencode/internal/common.hpp>
+#include <textencode/internal/nix.hpp>
+
+namespace textencode {
+
+// Compile time conversions of constants. Everything here is constexpr, so
+// invalid input is a compile error when evaluated as a constant expression
+// and throws std::runtime_error with the same messages as the converters
+// otherwise.
+
+template <EncodingType type>
+constexpr size_t encodedSize(size_t size) {
+    static_assert(type != EncodingType::Binary);
+    using Common = internal::Common<type>;
+    if constexpr (type == EncodingType::Nix32) {
+        return (size * 8 + 4) / 5;
+    } else {
+        constexpr size_t quantum_bytes = Common::quantum_bits / 8;
+        return (size + quantum_bytes - 1) / quantum_bytes *
+               Common::quantum_symbols;
+    }
+}
+
+// Bytes encoded by data, assuming it's valid
+template <EncodingType type>
+constexpr size_t decodedSize(std::string_view data) {
+    static_assert(type != EncodingType::Binary);
+    using Common = internal::Common<type>;
+    size_t num_symbols = 0;
+    for (const char symbol : data)
+        if (Common::validByte(
+                Common::inverse[static_cast<unsigned char>(symbol)]))
+            num_symbols += 1;
+    return num_symbols * Common::shift / 8;
+}
+
+template <EncodingType type, size_t size>
+constexpr std::array<char, encodedSize<type>(size)> encode(
+    const std::array<char, size>& data) {
+    using Common = internal::Common<type>;
+    std::array<char, encodedSize<type>(size)> ret{};
+
+    if constexpr (type == EncodingType::Nix32) {
+        // Same bit order as ToNix32::complete()
+        for (size_t i = 0; i < ret.size(); ++i) {
+            const size_t bit_offset = (ret.size() - i - 1) * 5;
+            const size_t byte_offset = bit_offset / 8;
+            const size_t byte_shift = bit_offset % 8;
+            const int upper = data[byte_offset] & 0xff;
+            const int lower =
+                byte_offset + 1 == size ? 0 : data[byte_offset + 1] & 0xff;
+            ret[i] = Common::symbols[((upper >> byte_shift) |
+                                      (lower << (8 - byte_shift))) &
+                                     0x1f];
+        }
+    } else {
+        size_t out = 0;
+        for (size_t bit = 0; bit < size * 8; bit += Common::shift) {
+            size_t value = 0;
+            for (size_t i = bit; i < bit + Common::shift; ++i) {
+                value <<= 1;
+                if (i < size * 8)
+                    value |= (data[i / 8] >> (7 - i % 8)) & 1;
+            }
+            ret[out++] = Common::symbols[value];
+        }
+        for (; out < ret.size(); ++out)
+            ret[out] = '=';
+    }
+
+    return ret;
+}
+
+// size must be decodedSize<type>(data)
+template <EncodingType type, size_t size>
+constexpr std::array<char, size> decode(std::string_view data) {
+    using Common = internal::Common<type>;
+    using internal::CharCodes;
+    std::array<char, size> ret{};
+
+    if constexpr (type == EncodingType::Nix32) {
+        // Validated like FromNix32, then each symbol's bits are placed
+        // starting from the least significant end
+        size_t num_symbols = 0;
+        for (const char symbol : data) {
+            const char byte =
+                Common::inverse[static_cast<unsigned char>(symbol)];
+            if (byte == static_cast<char>(CharCodes::Ignore))
+                continue;
+            if (!Common::validByte(byte))
+                throw std::runtime_error("Invalid symbol");
+            num_symbols += 1;
+        }
+        if ((num_symbols + 7) * 5 / 8 == (num_symbols + 8) * 5 / 8)
+            throw std::runtime_error("Invalid nix32 length");
+        if (num_symbols * 5 / 8 != size)
+            throw std::runtime_error("Wrong decoded size");
+
+        size_t pos = num_symbols;
+        for (const char symbol : data) {
+            const char byte =
+                Common::inverse[static_cast<unsigned char>(symbol)];
+            if (byte == static_cast<char>(CharCodes::Ignore))
+                continue;
+            pos -= 1;
+            for (size_t i = 0; i < 5; ++i) {
+                const size_t bit = pos * 5 + i;
+                if (((byte >> i) & 1) == 0)
+                    continue;
+                if (bit >= size * 8)
+                    throw std::runtime_error("Invalid nix32 hash");
+                ret[bit / 8] = static_cast<char>(ret[bit / 8] | 1 << bit % 8);
+            }
+        }
+    } else {
+        // Validated like FromBaseN
+        size_t num_symbols = 0, padding = 0, num_bits = 0, out = 0;
+        unsigned buffer = 0;
+        for (const char symbol : data) {
+            const char byte =
+                Common::inverse[static_cast<unsigned char>(symbol)];
+            if (byte == static_cast<char>(CharCodes::Ignore))
+                continue;
+            if (byte == static_cast<char>(CharCodes::Padding)) {
+                padding += 1;
+                continue;
+            }
+            if (padding > 0)
+                throw std::runtime_error("Invalid padding");
+            if (!Common::validByte(byte))
+                throw std::runtime_error("Invalid symbol");
+
+            num_symbols += 1;
+            buffer = (buffer << Common::shift) | byte;
+            num_bits += Common::shift;
+            if (num_bits >= 8) {
+                num_bits -= 8;
+                if (out == size)
+                    throw std::runtime_error("Wrong decoded size");
+                ret[out++] = static_cast<char>(buffer >> num_bits);
+                buffer &= (1u << num_bits) - 1;
+            }
+        }
+
+        if (padding >= Common::quantum_symbols)
+            throw std::runtime_error("Too much padding");
+        if ((num_symbols + padding) % Common::quantum_symbols != 0)
+            throw std::runtime_error("Bad input width");
+        if (buffer != 0)
+            throw std::runtime_error("Bad encoding");
+        if (num_bits >= Common::shift)
+            throw std::runtime_error("Invalid padding");
+        if (out != size)
+            throw std::runtime_error("Wrong decoded size");
+    }
+
+    return ret;
+}
+
+#if __cpp_nontype_template_args >= 201911L && __cpp_consteval >= 201811L
+
+namespace internal {
+
+// A string literal usable as a template argument
+template <size_t N>
+struct FixedString {
+    std::array<char, N> data{};
+
+    consteval FixedString(const char (&str)[N]) {
+        for (size_t i = 0; i < N; ++i)
+            data[i] = str[i];
+    }
+
+    consteval std::string_view view() const {
+        return {data.data(), N - 1};
+    }
+};
+
+template <EncodingType type, FixedString literal>
+consteval auto decodeLiteral() {
+    return decode<type, decodedSize<type>(literal.view())>(literal.view());
+}
+
+}  // namespace internal
+
+// Literals decoded at compile time, only available from C++20
+namespace literals {
+
+template <internal::FixedString literal>
+consteval auto operator""_hex() {
+    return internal::decodeLiteral<EncodingType::Base16, literal>();
+}
+
+template <internal::FixedString literal>
+consteval auto operator""_b32() {
+    return internal::decodeLiteral<EncodingType::Base32, literal>();
+}
+
+template <internal::FixedString literal>
+consteval auto operator""_nix32() {
+    return internal::decodeLiteral<EncodingType::Nix32, literal>();
+}
+
+template <internal::FixedString literal>
+consteval auto operator""_b64() {
+    return internal::decodeLiteral<EncodingType::Base64, literal>();
+}
+
+}  // namespace literals
+
+#endif
+
+}  // namespace textencode
+
+// Decodes a string literal at compile time in any language version, e.g.
+// constexpr auto key = TEXTENCODE_DECODE(EncodingType::Base64, "Zm9v");
+#define TEXTENCODE_DECODE(type, literal)                               \
+    ([] {                                                              \
+        constexpr std::string_view data = literal;                     \
+        constexpr auto size = ::textencode::decodedSize<type>(data);   \
+        constexpr auto ret = ::textencode::decode<type, size>(data);   \
+        return ret;                                                    \
+    }())
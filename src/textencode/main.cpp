@@ -1,19 +1,53 @@
+#include <fcntl.h>
+#include <sys/stat.h>
 #include <unistd.h>
+#include <csignal>
 #include <CLI/CLI.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
 #include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <system_error>
+#include <textencode/alphabet.hpp>
+#include <textencode/batch.hpp>
 #include <textencode/common.hpp>
+#include <textencode/detect.hpp>
 #include <textencode/fd.hpp>
+#include <textencode/hash.hpp>
+#include <textencode/server.hpp>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+using textencode::Alphabet;
+using textencode::DigestType;
 using textencode::EncodingType;
+using textencode::HashFormat;
 
 const std::unordered_map<std::string, EncodingType> type_map = {
     {"bin", EncodingType::Binary},    {"binary", EncodingType::Binary},
     {"base16", EncodingType::Base16}, {"hex", EncodingType::Base16},
     {"base32", EncodingType::Base32}, {"nix32", EncodingType::Nix32},
-    {"base64", EncodingType::Base64},
+    {"base58", EncodingType::Base58}, {"base64", EncodingType::Base64},
+    {"ascii85", EncodingType::Ascii85}, {"z85", EncodingType::Z85},
+};
+
+const std::unordered_map<std::string, DigestType> digest_map = {
+    {"sha256", DigestType::Sha256},
+    {"sha512", DigestType::Sha512},
+};
+
+const std::unordered_map<std::string, HashFormat> hash_format_map = {
+    {"base16", HashFormat::Base16}, {"hex", HashFormat::Base16},
+    {"nix32", HashFormat::Nix32},   {"base64", HashFormat::Base64},
+    {"sri", HashFormat::Sri},
 };
 
 std::string validateEncoding(const std::string& opt) {
@@ -22,20 +56,396 @@ std::string validateEncoding(const std::string& opt) {
     return opt + " is not a valid encoding type";
 }
 
+// The input type may also be left to detect()
+std::string validateSource(const std::string& opt) {
+    return opt == "auto" ? "" : validateEncoding(opt);
+}
+
+// Targets are written as TYPE or TYPE:PATH, the former going to stdout
+std::pair<std::string, std::string> splitTarget(const std::string& opt) {
+    const size_t pos = opt.find(':');
+    if (pos == std::string::npos)
+        return {opt, ""};
+    return {opt.substr(0, pos), opt.substr(pos + 1)};
+}
+
+std::string validateTarget(const std::string& opt) {
+    return validateEncoding(splitTarget(opt).first);
+}
+
+std::string validateDigest(const std::string& opt) {
+    if (digest_map.find(opt) != digest_map.end())
+        return "";
+    return opt + " is not a valid digest type";
+}
+
+std::string validateHashFormat(const std::string& opt) {
+    if (hash_format_map.find(opt) != hash_format_map.end())
+        return "";
+    return opt + " is not a valid hash format";
+}
+
+// Shards are written as N/M, counting from 0
+std::optional<std::pair<size_t, size_t>> parseShard(const std::string& opt) {
+    std::istringstream in(opt);
+    size_t index, count;
+    char slash;
+    if (!(in >> index >> slash >> count) || slash != '/' || !in.eof() ||
+        index >= count)
+        return std::nullopt;
+    return std::make_pair(index, count);
+}
+
+std::string validateShard(const std::string& opt) {
+    if (parseShard(opt))
+        return "";
+    return opt + " is not a shard N/M with N below M";
+}
+
+// A custom alphabet stands in for the base-n type with as many symbols
+bool replaces(const std::optional<Alphabet>& alphabet, EncodingType type) {
+    if (!alphabet || (type != EncodingType::Base16 &&
+                      type != EncodingType::Base32 &&
+                      type != EncodingType::Base64))
+        return false;
+    return Alphabet::standard(type).symbols().size() ==
+           alphabet->symbols().size();
+}
+
+class OutputFiles {
+  public:
+    ~OutputFiles() {
+        for (const int fd : fds)
+            close(fd);
+    }
+
+    int open(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+        if (fd < 0)
+            throw std::system_error(errno, std::generic_category(),
+                                    "Failed to open " + path);
+        fds.push_back(fd);
+        return fd;
+    }
+
+  private:
+    std::vector<int> fds;
+};
+
+// Each input goes to PATH.SUFFIX, or to DIR/NAME.SUFFIX with a directory
+std::vector<textencode::BatchFile> batchFiles(
+    const std::vector<std::string>& inputs, const std::string& dir,
+    const std::string& suffix) {
+    std::vector<textencode::BatchFile> ret;
+    for (const auto& input : inputs) {
+        std::string output = input + suffix;
+        if (!dir.empty())
+            output = dir + "/" + output.substr(output.rfind('/') + 1);
+        ret.push_back({input, output});
+    }
+    return ret;
+}
+
+int convertFiles(const std::vector<textencode::BatchFile>& files,
+                 EncodingType from, EncodingType to, size_t jobs,
+                 size_t split_size) {
+    const auto summary =
+        textencode::transcodeFiles(files, from, to, jobs, split_size);
+    for (const auto& failure : summary.failures)
+        std::cerr << "Error: " << failure.path << ": " << failure.error
+                  << std::endl;
+
+    const double mib = 1 << 20;
+    std::cerr << std::fixed << std::setprecision(1) << summary.files
+              << " files, " << summary.bytes_in / mib << " MiB in, "
+              << summary.bytes_out / mib << " MiB out in " << summary.seconds
+              << "s (" << summary.bytes_in / mib / summary.seconds
+              << " MiB/s), " << summary.failures.size() << " failed"
+              << std::endl;
+    return summary.failures.empty() ? 0 : 1;
+}
+
+// Converts shard index of count of stdin, which has to be a regular file.
+// Unless the shards are independent, each carries on from the checkpoint
+// file written by the one before.
+int convertShard(EncodingType from, EncodingType to, int fd_out,
+                 size_t index, size_t count, const std::string& checkpoint) {
+    struct stat st;
+    if (fstat(STDIN_FILENO, &st) != 0 || !S_ISREG(st.st_mode))
+        throw std::invalid_argument("--shard needs a regular file as input");
+    const auto [begin, end] =
+        textencode::shardRange(st.st_size, index, count, from, to);
+    const bool chained = !textencode::splittable(from, to);
+    const bool last = index + 1 == count;
+    if (chained && checkpoint.empty() && count > 1)
+        throw std::invalid_argument(
+            "Shards of this conversion need a --checkpoint file to carry "
+            "on from each other");
+
+    textencode::Checkpoint start;
+    start.offset = begin;
+    if (chained && index > 0) {
+        std::ifstream in(checkpoint, std::ios::binary);
+        const std::string data((std::istreambuf_iterator<char>(in)),
+                               std::istreambuf_iterator<char>());
+        if (!in)
+            throw std::runtime_error("Failed to read " + checkpoint);
+        start = textencode::Checkpoint::parse(data);
+        if (start.offset != begin)
+            throw std::invalid_argument(
+                "The checkpoint is at offset " + std::to_string(start.offset) +
+                " rather than the shard's start at " + std::to_string(begin));
+    }
+
+    std::optional<uint64_t> stop;
+    if (!last)
+        stop = end;
+    const auto reached = textencode::transcodeRange(
+        STDIN_FILENO, from, fd_out, to, start, stop, !chained);
+    if (!last && reached.offset != end)
+        throw std::runtime_error("The input shrank during conversion");
+
+    if (chained && !last) {
+        std::ofstream out(checkpoint, std::ios::binary | std::ios::trunc);
+        out << reached.serialize();
+        if (!out.flush())
+            throw std::runtime_error("Failed to write " + checkpoint);
+    }
+    return 0;
+}
+
+textencode::Server* server = nullptr;
+
+void stopServer(int) {
+    server->stop();
+}
+
+int serve(const std::string& path) {
+    textencode::Server s(path);
+    server = &s;
+    std::signal(SIGINT, stopServer);
+    std::signal(SIGTERM, stopServer);
+    s.run();
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     CLI::App app{"Text Encoding Converter"};
-    std::string to_str, from_str;
-    app.add_option("-t,--to", to_str, "The type to convert to")
-        ->required()
-        ->check(validateEncoding);
-    app.add_option("-f,--from", from_str, "The type to convert from")
-        ->required()
-        ->check(validateEncoding);
+    std::vector<std::string> to_strs;
+    std::string from_str, digest_str, digest_to_str = "hex";
+    std::string serve_path, connect_path, alphabet_str;
+    std::string hashes_str, hash_type_str;
+    std::vector<std::string> inputs;
+    std::string output_dir, suffix;
+    std::string shard_str, checkpoint_path;
+    bool lines = false, hash_prefix = false;
+    size_t jobs = 0, split_size = 0;
+    app.add_option("-t,--to", to_strs,
+                   "The type to convert to, optionally as TYPE:PATH")
+        ->check(validateTarget);
+    app.add_option("-f,--from", from_str,
+                   "The type to convert from, or auto to detect it")
+        ->check(validateSource);
+    app.add_option("--digest", digest_str,
+                   "Also hash the decoded data with this digest")
+        ->check(validateDigest);
+    app.add_option("--digest-encoding", digest_to_str,
+                   "The type to write the digest as, optionally as TYPE:PATH")
+        ->check(validateTarget);
+    app.add_option("--alphabet", alphabet_str,
+                   "Symbols replacing the base16, base32 or base64 alphabet "
+                   "of the same size");
+    app.add_flag("--lines", lines,
+                 "Convert each input line independently");
+    app.add_option("-j,--jobs", jobs,
+                   "Threads to use with --lines or input files, by default "
+                   "1 and one per core respectively");
+    app.add_option("inputs", inputs,
+                   "Files to convert, each written next to it with --suffix "
+                   "or into --output-dir");
+    app.add_option("--output-dir", output_dir,
+                   "The directory to write converted input files to");
+    app.add_option("--suffix", suffix,
+                   "Appended to converted input file names, by default "
+                   ".TYPE unless --output-dir is given");
+    app.add_option("--split", split_size,
+                   "Split input files larger than this many bytes across "
+                   "threads when encoding binary to a fixed width type");
+    app.add_option("--shard", shard_str,
+                   "Convert only shard N of M of the input file on stdin, "
+                   "counting from 0, so that the outputs concatenate to the "
+                   "whole conversion")
+        ->check(validateShard);
+    app.add_option("--checkpoint", checkpoint_path,
+                   "With --shard, the file each shard saves its state to "
+                   "for the next one to carry on from, when shards aren't "
+                   "independent");
+    app.add_option("--serve", serve_path,
+                   "Serve conversions on a unix socket at this path");
+    app.add_option("--connect", connect_path,
+                   "Convert through the server at this unix socket path");
+    app.add_option("--hashes", hashes_str,
+                   "Rewrite each input line's hash in this format: base16, "
+                   "nix32, base64 or sri")
+        ->check(validateHashFormat);
+    app.add_option("--hash-type", hash_type_str,
+                   "The type of hashes given without a type prefix")
+        ->check(validateDigest);
+    app.add_flag("--hash-prefix", hash_prefix,
+                 "Prefix rewritten hashes with their type, as in TYPE:HASH");
     CLI11_PARSE(app, argc, argv);
 
+    if (!hashes_str.empty()) {
+        if (!from_str.empty() || !to_strs.empty() || !digest_str.empty() ||
+            !serve_path.empty() || !connect_path.empty() ||
+            !alphabet_str.empty() || lines) {
+            std::cerr << "Error: --hashes can't be combined with other modes"
+                      << std::endl;
+            return 1;
+        }
+        try {
+            std::optional<DigestType> type;
+            if (!hash_type_str.empty())
+                type = digest_map.at(hash_type_str);
+            textencode::transcodeHashes(STDIN_FILENO, STDOUT_FILENO,
+                                        hash_format_map.at(hashes_str),
+                                        hash_prefix, type);
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+        }
+        return 1;
+    }
+
+    if (serve_path.empty() &&
+        (from_str.empty() || (to_strs.empty() && digest_str.empty()))) {
+        std::cerr << "Error: --from and one of --to or --digest are required"
+                  << std::endl;
+        return 1;
+    }
+    if ((lines || !connect_path.empty()) &&
+        (to_strs.size() != 1 || !digest_str.empty())) {
+        std::cerr << "Error: --lines and --connect take a single --to and no "
+                     "--digest"
+                  << std::endl;
+        return 1;
+    }
+    if (!inputs.empty() &&
+        (to_strs.size() != 1 || !digest_str.empty() ||
+         !alphabet_str.empty() || lines || !connect_path.empty() ||
+         splitTarget(to_strs[0]).second != "")) {
+        std::cerr << "Error: input files take a single --to without a path "
+                     "and no --digest, --alphabet, --lines or --connect"
+                  << std::endl;
+        return 1;
+    }
+    if (!alphabet_str.empty() && (lines || !connect_path.empty())) {
+        std::cerr << "Error: --alphabet can't be used with --lines or --connect"
+                  << std::endl;
+        return 1;
+    }
+
+    if (!shard_str.empty() &&
+        (to_strs.size() != 1 || !digest_str.empty() || lines ||
+         !connect_path.empty() || !inputs.empty() || !alphabet_str.empty() ||
+         from_str == "auto")) {
+        std::cerr << "Error: --shard takes a single --to and no --digest, "
+                     "--lines, --connect, --alphabet, input files or "
+                     "--from auto"
+                  << std::endl;
+        return 1;
+    }
+    if (!checkpoint_path.empty() && shard_str.empty()) {
+        std::cerr << "Error: --checkpoint is only used with --shard"
+                  << std::endl;
+        return 1;
+    }
+    if (from_str == "auto" &&
+        (lines || !connect_path.empty() || !inputs.empty() ||
+         !alphabet_str.empty())) {
+        std::cerr << "Error: --from auto can't be used with --lines, "
+                     "--connect, --alphabet or input files"
+                  << std::endl;
+        return 1;
+    }
+
     try {
-        textencode::transcode(STDIN_FILENO, type_map.at(from_str),
-                              STDOUT_FILENO, type_map.at(to_str));
+        if (!serve_path.empty())
+            return serve(serve_path);
+
+        if (!inputs.empty()) {
+            if (suffix.empty() && output_dir.empty())
+                suffix = "." + to_strs[0];
+            return convertFiles(batchFiles(inputs, output_dir, suffix),
+                                type_map.at(from_str), type_map.at(to_strs[0]),
+                                jobs, split_size);
+        }
+
+        std::optional<Alphabet> alphabet;
+        if (!alphabet_str.empty())
+            alphabet.emplace(alphabet_str);
+        const bool detect = from_str == "auto";
+        const EncodingType from =
+            detect ? EncodingType::Binary : type_map.at(from_str);
+        bool alphabet_used = replaces(alphabet, from);
+
+        // Two outputs sharing a file would overwrite each other
+        std::vector<std::string> targets = to_strs;
+        if (!digest_str.empty())
+            targets.push_back(digest_to_str);
+        std::vector<std::string> paths;
+        for (const auto& target : targets) {
+            const std::string path = splitTarget(target).second;
+            if (!path.empty())
+                paths.push_back(path);
+        }
+        textencode::checkDistinctFiles(paths);
+
+        OutputFiles files;
+        std::vector<textencode::Output> outputs;
+        for (const auto& to_str : to_strs) {
+            const auto [type, path] = splitTarget(to_str);
+            const int fd = path.empty() ? STDOUT_FILENO : files.open(path);
+            outputs.push_back({fd, type_map.at(type)});
+        }
+        if (!digest_str.empty()) {
+            const auto [type, path] = splitTarget(digest_to_str);
+            const int fd = path.empty() ? STDOUT_FILENO : files.open(path);
+            outputs.push_back(
+                {fd, type_map.at(type), digest_map.at(digest_str)});
+        }
+        for (auto& output : outputs) {
+            if (replaces(alphabet, output.type)) {
+                output.alphabet = alphabet;
+                alphabet_used = true;
+            }
+        }
+        if (alphabet && !alphabet_used)
+            throw std::invalid_argument(
+                "--alphabet doesn't match any base-n encoding used");
+
+        if (!shard_str.empty()) {
+            const auto [index, count] = *parseShard(shard_str);
+            return convertShard(from, outputs[0].type, outputs[0].fd, index,
+                                count, checkpoint_path);
+        }
+        if (detect)
+            textencode::transcode(STDIN_FILENO,
+                                  std::make_unique<textencode::FromAuto>(),
+                                  outputs);
+        else if (!connect_path.empty())
+            textencode::transcodeRemote(connect_path, STDIN_FILENO, from,
+                                        outputs[0].fd, outputs[0].type);
+        else if (lines)
+            textencode::transcodeLines(STDIN_FILENO, from, outputs[0].fd,
+                                       outputs[0].type, jobs);
+        else if (replaces(alphabet, from))
+            textencode::transcode(
+                STDIN_FILENO,
+                std::make_unique<textencode::FromCustomBaseN>(*alphabet),
+                outputs);
+        else
+            textencode::transcode(STDIN_FILENO, from, outputs);
         return 0;
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
@@ -1,9 +1,17 @@
+#include <cstddef>
+#include <map>
 #include <memory>
+#include <string>
+#include <textencode/base58.hpp>
+#include <textencode/base85.hpp>
 #include <textencode/base_n.hpp>
 #include <textencode/binary.hpp>
 #include <textencode/common.hpp>
+#include <textencode/digest.hpp>
 #include <textencode/map.hpp>
 #include <textencode/nix.hpp>
+#include <utility>
+#include <vector>
 
 namespace textencode {
 
@@ -12,7 +20,10 @@ const ConverterMap to_binary = {
     {EncodingType::Base16, []() { return std::make_unique<ToBase16>(); }},
     {EncodingType::Base32, []() { return std::make_unique<ToBase32>(); }},
     {EncodingType::Nix32, []() { return std::make_unique<ToNix32>(); }},
+    {EncodingType::Base58, []() { return std::make_unique<ToBase58>(); }},
     {EncodingType::Base64, []() { return std::make_unique<ToBase64>(); }},
+    {EncodingType::Ascii85, []() { return std::make_unique<ToAscii85>(); }},
+    {EncodingType::Z85, []() { return std::make_unique<ToZ85>(); }},
 };
 
 const ConverterMap from_binary = {
@@ -20,7 +31,83 @@ const ConverterMap from_binary = {
     {EncodingType::Base16, []() { return std::make_unique<FromBase16>(); }},
     {EncodingType::Base32, []() { return std::make_unique<FromBase32>(); }},
     {EncodingType::Nix32, []() { return std::make_unique<FromNix32>(); }},
+    {EncodingType::Base58, []() { return std::make_unique<FromBase58>(); }},
     {EncodingType::Base64, []() { return std::make_unique<FromBase64>(); }},
+    {EncodingType::Ascii85, []() { return std::make_unique<FromAscii85>(); }},
+    {EncodingType::Z85, []() { return std::make_unique<FromZ85>(); }},
+};
+
+namespace {
+
+// Converters may still be returned while thread locals are destroyed, after
+// the pool has gone, in which case they are simply deleted
+thread_local bool pool_destroyed = false;
+
+struct Pool {
+    std::map<std::pair<const ConverterMap*, EncodingType>,
+             std::vector<std::unique_ptr<Converter>>>
+        spare;
+
+    ~Pool() {
+        pool_destroyed = true;
+    }
+};
+
+Pool& threadPool() {
+    thread_local Pool pool;
+    return pool;
+}
+
+}  // namespace
+
+void PoolReturn::operator()(Converter* converter) const {
+    std::unique_ptr<Converter> owned(converter);
+    if (pool_destroyed || !map)
+        return;
+    try {
+        auto& spare = threadPool().spare[{map, type}];
+        if (spare.size() >= max_spare_converters)
+            return;
+        owned->reset();
+        spare.push_back(std::move(owned));
+    } catch (...) {
+        // Deleted rather than pooled
+    }
+}
+
+PooledConverter acquire(const ConverterMap& map, EncodingType type) {
+    const PoolReturn deleter(map, type);
+    if (!pool_destroyed) {
+        auto& spare = threadPool().spare[{&map, type}];
+        if (!spare.empty()) {
+            PooledConverter ret(spare.back().release(), deleter);
+            spare.pop_back();
+            return ret;
+        }
+    }
+    return PooledConverter(map.at(type)().release(), deleter);
+}
+
+void clearPool() {
+    if (!pool_destroyed)
+        threadPool().spare.clear();
+}
+
+const InPlaceMap in_place_from_binary = {
+    {EncodingType::Binary, [](char*, size_t size) { return size; }},
+    {EncodingType::Base16, FromBase16::decodeInPlace},
+    {EncodingType::Base32, FromBase32::decodeInPlace},
+    {EncodingType::Nix32, FromNix32::decodeInPlace},
+    {EncodingType::Base64, FromBase64::decodeInPlace},
+};
+
+void decodeInPlace(EncodingType type, std::string& data) {
+    data.resize(in_place_from_binary.at(type)(data.data(), data.size()));
+}
+
+const DigestMap digests = {
+    {DigestType::Sha256, []() { return std::make_unique<Sha256>(); }},
+    {DigestType::Sha512, []() { return std::make_unique<Sha512>(); }},
 };
 
 }  // namespace textencode
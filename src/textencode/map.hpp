@@ -1,7 +1,9 @@
 #pragma once
 
+#include <cstddef>
 #include <functional>
 #include <memory>
+#include <string>
 #include <textencode/common.hpp>
 #include <unordered_map>
 
@@ -14,4 +16,50 @@ using ConverterMap =
 extern const ConverterMap to_binary;
 extern const ConverterMap from_binary;
 
+// Resets a pooled converter and gives it back to the pool of the thread
+// destroying it
+class PoolReturn {
+  public:
+    PoolReturn() = default;
+    PoolReturn(const ConverterMap& map, EncodingType type)
+        : map(&map), type(type) {
+    }
+
+    void operator()(Converter* converter) const;
+
+  private:
+    const ConverterMap* map = nullptr;
+    EncodingType type = EncodingType::Binary;
+};
+
+using PooledConverter = std::unique_ptr<Converter, PoolReturn>;
+
+constexpr size_t max_spare_converters = 16;
+
+// Takes a converter for type from the calling thread's spare converters made
+// by map, such as to_binary or from_binary, making a new one only when there
+// are none. Once a thread has as many as it uses at a time, converters come
+// and go without allocating.
+//
+// Each thread keeps at most max_spare_converters for each map and type, and
+// further returned converters are deleted. Since reset() frees buffers over
+// 1 MiB, the pool holds at most that much per spare converter.
+PooledConverter acquire(const ConverterMap& map, EncodingType type);
+
+// Frees the calling thread's spare converters
+void clearPool();
+
+// Decodes over the front of the given buffer, returning the decoded size
+using InPlaceMap =
+    std::unordered_map<EncodingType, std::function<size_t(char*, size_t)>>;
+
+extern const InPlaceMap in_place_from_binary;
+
+void decodeInPlace(EncodingType type, std::string& data);
+
+using DigestMap =
+    std::unordered_map<DigestType, std::function<std::unique_ptr<Converter>()>>;
+
+extern const DigestMap digests;
+
 }  // namespace textencode
@@ -1,25 +1,65 @@
 #pragma once
 
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
 #include <textencode/common.hpp>
 
 namespace textencode {
+inline namespace TEXTENCODE_MODE {
 
+// Both converters keep all their input until complete(), allocated from
+// the given resource
 class ToNix32 : public Converter {
   public:
+    explicit ToNix32(std::pmr::memory_resource* resource =
+                         std::pmr::get_default_resource());
+
     std::string process(std::string_view data) override;
+    std::pmr::string process(std::string_view data,
+                             std::pmr::memory_resource* resource) override;
     std::string complete() override;
+    std::pmr::string complete(std::pmr::memory_resource* resource) override;
+    std::string snapshot() const override;
+    void restore(std::string_view state) override;
+    void reset() override;
 
   private:
-    std::string input;
+    std::pmr::string input;
+
+    template <typename String>
+    String completeAs(String ret);
 };
 
 class FromNix32 : public Converter {
   public:
+    explicit FromNix32(std::pmr::memory_resource* resource =
+                           std::pmr::get_default_resource());
+
     std::string process(std::string_view data) override;
+    std::pmr::string process(std::string_view data,
+                             std::pmr::memory_resource* resource) override;
     std::string complete() override;
+    std::pmr::string complete(std::pmr::memory_resource* resource) override;
+    std::string snapshot() const override;
+    void restore(std::string_view state) override;
+    void reset() override;
+
+    // Decodes data over its own front, returning the decoded size
+    static size_t decodeInPlace(char* data, size_t size);
 
   private:
-    std::string input;
+    // Symbol values, validated as they arrive
+    std::pmr::string input;
+
+    template <typename String>
+    String completeAs(String ret);
 };
 
+}  // namespace TEXTENCODE_MODE
 }  // namespace textencode
+
+#ifdef TEXTENCODE_HEADER_ONLY
+#include <textencode/impl/nix.hpp>
+#endif
@@ -0,0 +1,422 @@
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <textencode/internal/fd.hpp>
+#include <textencode/map.hpp>
+#include <textencode/server.hpp>
+#include <unordered_map>
+#include <utility>
+
+namespace textencode {
+
+namespace {
+
+using ResponseFrame = Server::ResponseFrame;
+
+// Chunks are bounded so a client can't make us buffer without limit
+constexpr size_t max_chunk = 1 << 20;
+// Nix32 and Base58 hold a whole request until it completes, so the total
+// input of requests using them is bounded as well
+constexpr uint64_t max_buffered_request = 16 << 20;
+constexpr size_t read_size = 1 << 16;
+
+bool buffersRequest(EncodingType type) {
+    return type == EncodingType::Nix32 || type == EncodingType::Base58;
+}
+
+void check(int ret, const char* what) {
+    if (ret < 0)
+        throw std::system_error(errno, std::generic_category(), what);
+}
+
+sockaddr_un socketAddress(const std::string& path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(addr.sun_path))
+        throw std::runtime_error("Socket path too long");
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return addr;
+}
+
+// Removes a socket left at path by a server that has gone. Anything else
+// there is refused, including the socket of a server still running.
+void removeStale(const std::string& path, const sockaddr_un& addr) {
+    struct stat st;
+    if (lstat(path.c_str(), &st) < 0) {
+        if (errno == ENOENT)
+            return;
+        check(-1, "Failed to stat socket path");
+    }
+    if (!S_ISSOCK(st.st_mode))
+        throw std::runtime_error(path + " exists and is not a socket");
+
+    const int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    check(sock, "Failed to create socket");
+    const int ret =
+        connect(sock, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+    const int error = errno;
+    close(sock);
+    if (ret == 0)
+        throw std::runtime_error("A server is already running at " + path);
+    if (error != ECONNREFUSED)
+        throw std::system_error(error, std::generic_category(),
+                                "Failed to probe socket");
+    if (unlink(path.c_str()) < 0 && errno != ENOENT)
+        check(-1, "Failed to remove stale socket");
+}
+
+uint32_t loadLength(const char* data) {
+    uint32_t ret = 0;
+    for (size_t i = 4; i > 0; --i)
+        ret = (ret << 8) | (data[i - 1] & 0xff);
+    return ret;
+}
+
+void appendLength(std::string& out, uint32_t length) {
+    for (size_t i = 0; i < 4; ++i)
+        out += static_cast<char>(length >> (i * 8));
+}
+
+void appendFrame(std::string& out, ResponseFrame kind, std::string_view data) {
+    out += static_cast<char>(kind);
+    appendLength(out, data.size());
+    out += data;
+}
+
+class Connection {
+  public:
+    explicit Connection(int fd) : fd(fd) {
+    }
+    ~Connection() {
+        close(fd);
+    }
+
+    uint32_t events = EPOLLIN;
+
+    // Both return false once the connection should be dropped
+    bool readable() {
+        while (wantsRead()) {
+            const size_t offset = input.size();
+            input.resize(offset + read_size);
+            const ssize_t ret = ::read(fd, input.data() + offset, read_size);
+            if (ret < 0) {
+                const int error = errno;
+                input.resize(offset);
+                return error == EAGAIN || error == EINTR;
+            }
+            input.resize(offset + ret);
+            if (ret == 0)
+                return false;
+            parse();
+        }
+        return true;
+    }
+
+    bool writable() {
+        while (!output.empty()) {
+            const ssize_t ret =
+                send(fd, output.data(), output.size(), MSG_NOSIGNAL);
+            if (ret < 0) {
+                if (errno == EAGAIN)
+                    break;
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+            output.erase(0, ret);
+        }
+        return !(closing && output.empty());
+    }
+
+    uint32_t wantedEvents() const {
+        uint32_t ret = 0;
+        if (wantsRead())
+            ret |= EPOLLIN;
+        if (!output.empty())
+            ret |= EPOLLOUT;
+        return ret;
+    }
+
+  private:
+    int fd;
+    std::string input, output;
+    PooledConverter from, to;
+    // The request's input so far, when it is limited
+    std::optional<uint64_t> request_size;
+    bool closing = false;
+
+    // Stop reading while the client isn't keeping up with our output
+    bool wantsRead() const {
+        return !closing && output.size() < max_chunk;
+    }
+
+    void parse() {
+        size_t offset = 0;
+        try {
+            while (!closing) {
+                const std::string_view data =
+                    std::string_view(input).substr(offset);
+                if (!from) {
+                    if (data.size() < 2)
+                        break;
+                    const auto from_type = static_cast<EncodingType>(data[0]);
+                    const auto to_type = static_cast<EncodingType>(data[1]);
+                    if (!from_binary.count(from_type) ||
+                        !to_binary.count(to_type))
+                        throw std::runtime_error("Invalid encoding type");
+                    from = acquire(from_binary, from_type);
+                    to = acquire(to_binary, to_type);
+                    if (buffersRequest(from_type) || buffersRequest(to_type))
+                        request_size = 0;
+                    offset += 2;
+                    continue;
+                }
+
+                if (data.size() < 4)
+                    break;
+                const uint32_t length = loadLength(data.data());
+                if (length > max_chunk)
+                    throw std::runtime_error("Chunk too large");
+                if (data.size() < 4 + length)
+                    break;
+                offset += 4 + length;
+                if (request_size &&
+                    (*request_size += length) > max_buffered_request)
+                    throw std::runtime_error("Request too large");
+
+                if (length > 0) {
+                    const std::string ret =
+                        to->process(from->process(data.substr(4, length)));
+                    if (!ret.empty())
+                        appendFrame(output, ResponseFrame::Data, ret);
+                    continue;
+                }
+
+                std::string ret = to->process(from->complete());
+                ret += to->complete();
+                if (!ret.empty())
+                    appendFrame(output, ResponseFrame::Data, ret);
+                appendFrame(output, ResponseFrame::Done, {});
+                from.reset();
+                to.reset();
+                request_size.reset();
+            }
+        } catch (const std::exception& e) {
+            appendFrame(output, ResponseFrame::Error, e.what());
+            closing = true;
+        }
+        input.erase(0, offset);
+    }
+};
+
+}  // namespace
+
+Server::Server(const std::string& path) : path(path) {
+    try {
+        const sockaddr_un addr = socketAddress(path);
+        listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                          0);
+        check(listener, "Failed to create socket");
+        removeStale(path, addr);
+        check(bind(listener, reinterpret_cast<const sockaddr*>(&addr),
+                   sizeof(addr)),
+              "Failed to bind socket");
+        struct stat st;
+        check(lstat(path.c_str(), &st), "Failed to stat socket");
+        socket_id = {st.st_dev, st.st_ino};
+        check(listen(listener, SOMAXCONN), "Failed to listen on socket");
+
+        epoll = epoll_create1(EPOLL_CLOEXEC);
+        check(epoll, "Failed to create epoll");
+        wake = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        check(wake, "Failed to create eventfd");
+
+        for (const int fd : {listener, wake}) {
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.fd = fd;
+            check(epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event),
+                  "Failed to watch fd");
+        }
+    } catch (...) {
+        cleanup();
+        throw;
+    }
+}
+
+Server::~Server() {
+    cleanup();
+}
+
+void Server::cleanup() {
+    for (const int fd : {listener, epoll, wake})
+        if (fd >= 0)
+            close(fd);
+    // The path may have been replaced since we bound it
+    struct stat st;
+    if (socket_id && lstat(path.c_str(), &st) == 0 &&
+        socket_id == std::make_pair(st.st_dev, st.st_ino))
+        unlink(path.c_str());
+}
+
+void Server::run() {
+    std::unordered_map<int, std::unique_ptr<Connection>> connections;
+    epoll_event events[64];
+
+    for (bool stopped = false; !stopped;) {
+        const int num = epoll_wait(epoll, events, 64, -1);
+        if (num < 0 && errno == EINTR)
+            continue;
+        check(num, "Failed to wait for events");
+
+        for (int i = 0; i < num; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == wake) {
+                stopped = true;
+                continue;
+            }
+
+            if (fd == listener) {
+                int client;
+                while ((client = accept4(listener, nullptr, nullptr,
+                                         SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                    epoll_event event{};
+                    event.events = EPOLLIN;
+                    event.data.fd = client;
+                    if (epoll_ctl(epoll, EPOLL_CTL_ADD, client, &event) < 0) {
+                        close(client);
+                        continue;
+                    }
+                    connections[client] = std::make_unique<Connection>(client);
+                }
+                continue;
+            }
+
+            auto& connection = *connections.at(fd);
+            const uint32_t ready = events[i].events;
+            bool alive = (ready & EPOLLIN) || !(ready & (EPOLLERR | EPOLLHUP));
+            if (alive && (ready & EPOLLIN))
+                alive = connection.readable();
+            // Replies are usually small enough to send straight away
+            if (alive)
+                alive = connection.writable();
+
+            const uint32_t wanted = connection.wantedEvents();
+            if (alive && wanted != connection.events) {
+                epoll_event event{};
+                event.events = wanted;
+                event.data.fd = fd;
+                alive = epoll_ctl(epoll, EPOLL_CTL_MOD, fd, &event) == 0;
+                connection.events = wanted;
+            }
+            if (!alive) {
+                epoll_ctl(epoll, EPOLL_CTL_DEL, fd, nullptr);
+                connections.erase(fd);
+            }
+        }
+    }
+}
+
+void Server::stop() {
+    const uint64_t value = 1;
+    [[maybe_unused]] const ssize_t ret = ::write(wake, &value, sizeof(value));
+}
+
+void transcodeRemote(const std::string& path, int fd_in, EncodingType from,
+                     int fd_out, EncodingType to) {
+    const sockaddr_un addr = socketAddress(path);
+    const int sock = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    check(sock, "Failed to create socket");
+    struct Closer {
+        int fd;
+        ~Closer() {
+            close(fd);
+        }
+    } closer{sock};
+    check(connect(sock, reinterpret_cast<const sockaddr*>(&addr),
+                  sizeof(addr)),
+          "Failed to connect to server");
+
+    std::string request, response;
+    request += static_cast<char>(from);
+    request += static_cast<char>(to);
+    bool input_done = false;
+
+    // Requests and responses are interleaved so neither side can block the
+    // other when the server applies backpressure
+    for (;;) {
+        pollfd fds[2] = {{sock, POLLIN, 0}, {fd_in, 0, 0}};
+        if (!request.empty())
+            fds[0].events |= POLLOUT;
+        if (!input_done && request.size() < max_chunk)
+            fds[1].events = POLLIN;
+        const int num = poll(fds, fds[1].events ? 2 : 1, -1);
+        if (num < 0 && errno == EINTR)
+            continue;
+        check(num, "Failed to poll");
+
+        if (fds[1].revents) {
+            // The length is filled in after reading, and a zero length left
+            // behind at EOF is exactly the request terminator
+            const size_t offset = request.size();
+            request.resize(offset + 4);
+            if (internal::readAppend(fd_in, request, read_size)) {
+                const uint32_t length = request.size() - offset - 4;
+                for (size_t i = 0; i < 4; ++i)
+                    request[offset + i] = static_cast<char>(length >> (i * 8));
+            } else {
+                input_done = true;
+            }
+        }
+
+        if (fds[0].revents & POLLOUT) {
+            const ssize_t ret = send(sock, request.data(), request.size(),
+                                     MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (ret >= 0)
+                request.erase(0, ret);
+            else if (errno != EAGAIN && errno != EINTR)
+                check(ret, "Failed to send request");
+        }
+
+        if (fds[0].revents & (POLLIN | POLLHUP | POLLERR)) {
+            if (!internal::readAppend(sock, response, read_size))
+                throw std::runtime_error("Server closed connection");
+            size_t offset = 0;
+            while (response.size() - offset >= 5) {
+                const uint32_t length = loadLength(&response[offset + 1]);
+                if (response.size() - offset - 5 < length)
+                    break;
+                const std::string_view data =
+                    std::string_view(response).substr(offset + 5, length);
+                switch (static_cast<ResponseFrame>(response[offset])) {
+                    case ResponseFrame::Data:
+                        internal::write(fd_out, data);
+                        break;
+                    case ResponseFrame::Done:
+                        return;
+                    case ResponseFrame::Error:
+                        throw std::runtime_error(std::string(data));
+                    default:
+                        throw std::runtime_error("Invalid response");
+                }
+                offset += 5 + length;
+            }
+            response.erase(0, offset);
+        }
+    }
+}
+
+}  // namespace textencode
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <sys/types.h>
+#include <optional>
+#include <string>
+#include <textencode/common.hpp>
+#include <utility>
+
+namespace textencode {
+
+// Serves conversions over a unix stream socket to any number of clients.
+//
+// A request is two bytes, the from and to EncodingType, followed by chunks
+// of input each prefixed with a little endian uint32 length. A zero length
+// chunk completes the request, after which the connection may be reused.
+// Responses are frames of a one byte ResponseFrame, a little endian uint32
+// length and that many bytes. An Error frame closes the connection.
+//
+// Chunks are limited to 1 MiB, and requests to or from Nix32 or Base58,
+// which are held in memory until they complete, to 16 MiB in total.
+class Server {
+  public:
+    enum class ResponseFrame : char {
+        Data = 0,
+        Done = 1,
+        Error = 2,
+    };
+
+    // Binds to path, replacing a stale socket left there. Throws if anything
+    // else is at path, including a live server's socket.
+    explicit Server(const std::string& path);
+    ~Server();
+
+    // Runs the event loop until stop() is called
+    void run();
+    // Can be called from any thread or signal handler
+    void stop();
+
+  private:
+    std::string path;
+    int listener = -1;
+    int epoll = -1;
+    int wake = -1;
+    // The device and inode of our socket, which is only removed from path
+    // while it is still there
+    std::optional<std::pair<dev_t, ino_t>> socket_id;
+
+    void cleanup();
+};
+
+// Client side of Server, converting fd_in to fd_out via the socket at path
+void transcodeRemote(const std::string& path, int fd_in, EncodingType from,
+                     int fd_out, EncodingType to);
+
+}  // namespace textencode
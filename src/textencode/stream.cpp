@@ -0,0 +1,108 @@
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <textencode/stream.hpp>
+#include <utility>
+
+namespace textencode {
+
+namespace {
+
+size_t checkBufferSize(size_t buffer_size) {
+    if (buffer_size == 0)
+        throw std::invalid_argument("Stream buffer size must not be 0");
+    return buffer_size;
+}
+
+}  // namespace
+
+EncodingStreambuf::EncodingStreambuf(std::unique_ptr<Converter> converter,
+                                     std::streambuf* sink, size_t buffer_size)
+    : converter(std::move(converter)),
+      sink(sink),
+      buffer(checkBufferSize(buffer_size), '\0') {
+    setp(buffer.data(), buffer.data() + buffer.size());
+}
+
+EncodingStreambuf::~EncodingStreambuf() {
+    try {
+        close();
+    } catch (...) {
+    }
+}
+
+void EncodingStreambuf::close() {
+    if (closed)
+        return;
+    closed = true;
+    flushBuffer();
+    setp(nullptr, nullptr);
+    writeSink(converter->complete());
+    sink->pubsync();
+}
+
+EncodingStreambuf::int_type EncodingStreambuf::overflow(int_type ch) {
+    if (closed || !flushBuffer())
+        return traits_type::eof();
+    if (traits_type::eq_int_type(ch, traits_type::eof()))
+        return traits_type::not_eof(ch);
+    *pptr() = traits_type::to_char_type(ch);
+    pbump(1);
+    return ch;
+}
+
+std::streamsize EncodingStreambuf::xsputn(const char* data,
+                                          std::streamsize size) {
+    // Large writes skip the copy through our buffer
+    if (closed || static_cast<size_t>(size) < buffer.size())
+        return std::streambuf::xsputn(data, size);
+    if (!flushBuffer() ||
+        !writeSink(converter->process(std::string_view(data, size))))
+        return 0;
+    return size;
+}
+
+int EncodingStreambuf::sync() {
+    if (closed)
+        return 0;
+    return flushBuffer() && sink->pubsync() == 0 ? 0 : -1;
+}
+
+bool EncodingStreambuf::flushBuffer() {
+    const std::string_view data(pbase(), pptr() - pbase());
+    setp(buffer.data(), buffer.data() + buffer.size());
+    return writeSink(converter->process(data));
+}
+
+bool EncodingStreambuf::writeSink(const std::string& data) {
+    return sink->sputn(data.data(), data.size()) ==
+           static_cast<std::streamsize>(data.size());
+}
+
+DecodingStreambuf::DecodingStreambuf(std::unique_ptr<Converter> converter,
+                                     std::streambuf* source,
+                                     size_t buffer_size)
+    : converter(std::move(converter)),
+      source(source),
+      input(checkBufferSize(buffer_size), '\0') {
+}
+
+DecodingStreambuf::int_type DecodingStreambuf::underflow() {
+    while (!completed) {
+        const std::streamsize size = source->sgetn(input.data(), input.size());
+        if (size > 0) {
+            output = converter->process(std::string_view(input.data(), size));
+        } else {
+            output = converter->complete();
+            completed = true;
+        }
+
+        if (!output.empty()) {
+            setg(output.data(), output.data(), output.data() + output.size());
+            return traits_type::to_int_type(output[0]);
+        }
+    }
+    return traits_type::eof();
+}
+
+}  // namespace textencode
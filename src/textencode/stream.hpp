@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <textencode/common.hpp>
+
+namespace textencode {
+
+// Passes everything written to it through a converter into sink. Output is
+// buffered and processed in bulk, and sync() forwards all of it. The
+// converter is completed by close() or on destruction, since a completed
+// converter can't take more data. A buffer_size of 0 throws
+// std::invalid_argument.
+class EncodingStreambuf : public std::streambuf {
+  public:
+    EncodingStreambuf(std::unique_ptr<Converter> converter,
+                      std::streambuf* sink, size_t buffer_size = 1 << 16);
+    ~EncodingStreambuf() override;
+
+    void close();
+
+  protected:
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(const char* data, std::streamsize size) override;
+    int sync() override;
+
+  private:
+    std::unique_ptr<Converter> converter;
+    std::streambuf* sink;
+    std::string buffer;
+    bool closed = false;
+
+    bool flushBuffer();
+    bool writeSink(const std::string& data);
+};
+
+// Reads from source through a converter, completing it at the end of source.
+// Converter errors propagate out of the reading stream's operations. A
+// buffer_size of 0 throws std::invalid_argument.
+class DecodingStreambuf : public std::streambuf {
+  public:
+    DecodingStreambuf(std::unique_ptr<Converter> converter,
+                      std::streambuf* source, size_t buffer_size = 1 << 16);
+
+  protected:
+    int_type underflow() override;
+
+  private:
+    std::unique_ptr<Converter> converter;
+    std::streambuf* source;
+    std::string input, output;
+    bool completed = false;
+};
+
+}  // namespace textencode
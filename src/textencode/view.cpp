@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <textencode/internal/base_n.hpp>
+#include <textencode/internal/common.hpp>
+#include <textencode/view.hpp>
+
+namespace textencode {
+
+using internal::CharCodes;
+using internal::Common;
+
+namespace {
+
+template <EncodingType type>
+char symbolValue(char symbol) {
+    return Common<type>::inverse[static_cast<unsigned char>(symbol)];
+}
+
+}  // namespace
+
+template <EncodingType type>
+DecodedView<type>::DecodedView(std::string_view data) : data(data) {
+    size_t padding = 0;
+    size_t end = data.size();
+    for (; end > 0; --end) {
+        const char byte = symbolValue<type>(data[end - 1]);
+        if (byte == static_cast<char>(CharCodes::Padding))
+            padding += 1;
+        else if (byte != static_cast<char>(CharCodes::Ignore))
+            break;
+    }
+    num_symbols = end;
+    setSize(padding);
+}
+
+template <EncodingType type>
+DecodedView<type>::DecodedView(std::string_view data, size_t index_stride)
+    : data(data), index_stride(index_stride) {
+    if (index_stride == 0)
+        throw std::invalid_argument("Index stride must be positive");
+    index.reserve(data.size() / index_stride + 1);
+
+    size_t padding = 0;
+    for (size_t i = 0; i < data.size(); ++i) {
+        const char byte = symbolValue<type>(data[i]);
+        if (byte == static_cast<char>(CharCodes::Ignore))
+            continue;
+        if (byte == static_cast<char>(CharCodes::Padding)) {
+            padding += 1;
+            continue;
+        }
+        if (padding > 0)
+            throw std::runtime_error("Invalid padding");
+        if (num_symbols % index_stride == 0)
+            index.push_back(i);
+        num_symbols += 1;
+    }
+    setSize(padding);
+}
+
+template <EncodingType type>
+void DecodedView<type>::setSize(size_t padding_symbols) {
+    constexpr auto shift = Common<type>::shift;
+    constexpr auto quantum_symbols = Common<type>::quantum_symbols;
+    if (padding_symbols >= quantum_symbols)
+        throw std::runtime_error("Too much padding");
+    if ((num_symbols + padding_symbols) % quantum_symbols != 0)
+        throw std::runtime_error("Bad input width");
+    decoded_size = num_symbols * shift / 8;
+}
+
+template <EncodingType type>
+std::string DecodedView<type>::read(size_t offset, size_t size) const {
+    constexpr auto quantum_bytes = Common<type>::quantum_bits / 8;
+    if (offset > decoded_size || size > decoded_size - offset)
+        throw std::out_of_range("Read past end of view");
+    if (size == 0)
+        return {};
+
+    const size_t first = offset / quantum_bytes;
+    const size_t last = (offset + size - 1) / quantum_bytes;
+    std::string ret((last - first + 1) * quantum_bytes, '\0');
+    char* out = ret.data();
+    for (size_t quantum = first; quantum <= last; ++quantum)
+        out += decodeQuantum(quantum, out);
+
+    return ret.substr(offset - first * quantum_bytes, size);
+}
+
+template <EncodingType type>
+char DecodedView<type>::operator[](size_t offset) const {
+    size_t quantum = -1;
+    std::array<char, 8> bytes;
+    return cachedByte(offset, quantum, bytes);
+}
+
+template <EncodingType type>
+size_t DecodedView<type>::locate(size_t symbol) const {
+    if (index.empty())
+        return symbol;
+
+    size_t pos = index[symbol / index_stride];
+    for (size_t skip = symbol % index_stride; skip > 0; ++pos)
+        if (symbolValue<type>(data[pos]) != static_cast<char>(CharCodes::Ignore))
+            skip -= 1;
+    while (symbolValue<type>(data[pos]) == static_cast<char>(CharCodes::Ignore))
+        ++pos;
+    return pos;
+}
+
+template <EncodingType type>
+size_t DecodedView<type>::decodeQuantum(size_t quantum, char* out) const {
+    constexpr auto shift = Common<type>::shift;
+    constexpr auto quantum_symbols = Common<type>::quantum_symbols;
+
+    const size_t first = quantum * quantum_symbols;
+    const size_t count = std::min(quantum_symbols, num_symbols - first);
+    uint64_t buffer = 0;
+    size_t num_bits = 0;
+    for (size_t pos = locate(first), i = 0; i < count; ++pos) {
+        const char byte = symbolValue<type>(data[pos]);
+        if (byte == static_cast<char>(CharCodes::Ignore) && !index.empty())
+            continue;
+        if (!Common<type>::validByte(byte))
+            throw std::runtime_error("Invalid symbol");
+        buffer = (buffer << shift) | byte;
+        num_bits += shift;
+        i += 1;
+    }
+
+    const size_t num_bytes = num_bits / 8;
+    num_bits %= 8;
+    if (buffer & ((1 << num_bits) - 1))
+        throw std::runtime_error("Bad encoding");
+    if (num_bits >= shift)
+        throw std::runtime_error("Invalid padding");
+
+    for (size_t i = 0; i < num_bytes; ++i)
+        out[i] = buffer >> (num_bits + (num_bytes - 1 - i) * 8);
+    return num_bytes;
+}
+
+template <EncodingType type>
+char DecodedView<type>::cachedByte(size_t offset, size_t& quantum,
+                                   std::array<char, 8>& bytes) const {
+    constexpr auto quantum_bytes = Common<type>::quantum_bits / 8;
+    if (offset >= decoded_size)
+        throw std::out_of_range("Read past end of view");
+    if (offset / quantum_bytes != quantum) {
+        quantum = offset / quantum_bytes;
+        decodeQuantum(quantum, bytes.data());
+    }
+    return bytes[offset % quantum_bytes];
+}
+
+template class DecodedView<EncodingType::Base16>;
+template class DecodedView<EncodingType::Base32>;
+template class DecodedView<EncodingType::Base64>;
+
+}  // namespace textencode
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <textencode/common.hpp>
+#include <vector>
+
+namespace textencode {
+
+// Random access to the bytes encoded by a base-n string, decoding only the
+// quanta touched by each access. The data is not copied and must outlive the
+// view. Symbols are validated as they are decoded.
+template <EncodingType type>
+class DecodedView {
+  public:
+    class Iterator;
+
+    // For input without any ignored characters like newlines
+    explicit DecodedView(std::string_view data);
+    // Indexes every index_stride symbols so wrapped input seeks in O(stride)
+    DecodedView(std::string_view data, size_t index_stride);
+
+    size_t size() const {
+        return decoded_size;
+    }
+
+    std::string read(size_t offset, size_t size) const;
+    char operator[](size_t offset) const;
+
+    Iterator begin() const {
+        return Iterator(this, 0);
+    }
+    Iterator end() const {
+        return Iterator(this, decoded_size);
+    }
+
+    class Iterator {
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = char;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = char;
+
+        Iterator() = default;
+        Iterator(const DecodedView* view, size_t offset)
+            : view(view), offset(offset) {
+        }
+
+        char operator*() const {
+            return view->cachedByte(offset, quantum, bytes);
+        }
+        char operator[](difference_type n) const {
+            return *(*this + n);
+        }
+
+        Iterator& operator++() {
+            ++offset;
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator ret = *this;
+            ++offset;
+            return ret;
+        }
+        Iterator& operator--() {
+            --offset;
+            return *this;
+        }
+        Iterator operator--(int) {
+            Iterator ret = *this;
+            --offset;
+            return ret;
+        }
+        Iterator& operator+=(difference_type n) {
+            offset += n;
+            return *this;
+        }
+        Iterator& operator-=(difference_type n) {
+            offset -= n;
+            return *this;
+        }
+        Iterator operator+(difference_type n) const {
+            return Iterator(*this) += n;
+        }
+        friend Iterator operator+(difference_type n, const Iterator& it) {
+            return it + n;
+        }
+        Iterator operator-(difference_type n) const {
+            return Iterator(*this) -= n;
+        }
+        difference_type operator-(const Iterator& other) const {
+            return offset - other.offset;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return offset == other.offset;
+        }
+        bool operator!=(const Iterator& other) const {
+            return offset != other.offset;
+        }
+        bool operator<(const Iterator& other) const {
+            return offset < other.offset;
+        }
+        bool operator>(const Iterator& other) const {
+            return offset > other.offset;
+        }
+        bool operator<=(const Iterator& other) const {
+            return offset <= other.offset;
+        }
+        bool operator>=(const Iterator& other) const {
+            return offset >= other.offset;
+        }
+
+      private:
+        const DecodedView* view = nullptr;
+        size_t offset = 0;
+        // The most recently decoded quantum, shared by its bytes
+        mutable size_t quantum = -1;
+        mutable std::array<char, 8> bytes;
+    };
+
+  private:
+    std::string_view data;
+    size_t num_symbols = 0;
+    size_t decoded_size = 0;
+    size_t index_stride = 0;
+    // Offset into data of every index_stride'th symbol
+    std::vector<size_t> index;
+
+    void setSize(size_t padding_symbols);
+    size_t locate(size_t symbol) const;
+    size_t decodeQuantum(size_t quantum, char* out) const;
+    char cachedByte(size_t offset, size_t& quantum,
+                    std::array<char, 8>& bytes) const;
+};
+
+using DecodedView16 = DecodedView<EncodingType::Base16>;
+using DecodedView32 = DecodedView<EncodingType::Base32>;
+using DecodedView64 = DecodedView<EncodingType::Base64>;
+
+}  // namespace textencode
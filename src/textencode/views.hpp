@@ -0,0 +1,283 @@
+#pragma once
+
+// Lazy range adaptors, only available when compiling as C++20 or later
+#if __cplusplus >= 202002L && __has_include(<ranges>)
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <textencode/common.hpp>
+#include <textencode/internal/base_n.hpp>
+#include <textencode/internal/common.hpp>
+#include <utility>
+
+namespace textencode::views {
+
+template <typename V>
+concept ByteView = std::ranges::view<V> && std::ranges::input_range<V> &&
+                   std::convertible_to<std::ranges::range_reference_t<V>, char>;
+
+// Input the bulk kernels can read straight from memory
+template <typename V>
+inline constexpr bool contiguous =
+    std::ranges::contiguous_range<V> &&
+    std::sized_sentinel_for<std::ranges::sentinel_t<V>,
+                            std::ranges::iterator_t<V>> &&
+    sizeof(std::ranges::range_value_t<V>) == 1;
+
+// Symbols are produced a block at a time, straight from the bulk kernels
+// when the input is contiguous and otherwise one quantum per refill
+template <ByteView V, EncodingType type>
+class EncodeView : public std::ranges::view_interface<EncodeView<V, type>> {
+    using Common = internal::Common<type>;
+    static constexpr size_t quantum_bytes = Common::quantum_bits / 8;
+    static constexpr size_t block_quanta = 64 / Common::quantum_symbols;
+
+  public:
+    class Iterator {
+      public:
+        using iterator_concept = std::input_iterator_tag;
+        using value_type = char;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+        Iterator(EncodeView* parent, std::ranges::iterator_t<V> current)
+            : parent(parent), current(std::move(current)) {
+            fill();
+        }
+
+        char operator*() const {
+            return block[pos];
+        }
+        Iterator& operator++() {
+            if (++pos == len)
+                fill();
+            return *this;
+        }
+        void operator++(int) {
+            ++*this;
+        }
+        friend bool operator==(const Iterator& it, std::default_sentinel_t) {
+            return it.len == 0;
+        }
+
+      private:
+        EncodeView* parent = nullptr;
+        std::ranges::iterator_t<V> current;
+        std::array<char, block_quanta * Common::quantum_symbols> block;
+        uint8_t pos = 0;
+        uint8_t len = 0;
+
+        void fill() {
+            const auto end = std::ranges::end(parent->base);
+            pos = 0;
+            len = 0;
+
+            if constexpr (contiguous<V>) {
+                const size_t quanta = std::min<size_t>(
+                    (end - current) / quantum_bytes, block_quanta);
+                if (quanta > 0) {
+                    internal::encodeQuanta<type>(
+                        reinterpret_cast<const char*>(
+                            std::to_address(current)),
+                        quanta, block.data());
+                    current += quanta * quantum_bytes;
+                    len = quanta * Common::quantum_symbols;
+                    return;
+                }
+            }
+
+            uint64_t buffer = 0;
+            size_t num_bytes = 0;
+            for (; num_bytes < quantum_bytes && current != end; ++current) {
+                buffer = (buffer << 8) | (static_cast<char>(*current) & 0xff);
+                num_bytes += 1;
+            }
+            if (num_bytes == 0)
+                return;
+
+            // Pad a short final quantum exactly like ToBaseN::complete()
+            buffer <<= (quantum_bytes - num_bytes) * 8;
+            const size_t symbols =
+                (num_bytes * 8 + Common::shift - 1) / Common::shift;
+            constexpr size_t mask = Common::symbols.size() - 1;
+            for (size_t i = 0; i < Common::quantum_symbols; ++i) {
+                const size_t shift =
+                    (Common::quantum_symbols - 1 - i) * Common::shift;
+                block[i] = i < symbols ? Common::symbols[(buffer >> shift) & mask]
+                                       : '=';
+            }
+            len = Common::quantum_symbols;
+        }
+    };
+
+    EncodeView() = default;
+    explicit EncodeView(V base) : base(std::move(base)) {
+    }
+
+    Iterator begin() {
+        return Iterator(this, std::ranges::begin(base));
+    }
+    std::default_sentinel_t end() const {
+        return {};
+    }
+
+  private:
+    V base;
+};
+
+// Decodes with the same validation as FromBaseN, throwing std::runtime_error
+// from the iterator as soon as invalid input is reached
+template <ByteView V, EncodingType type>
+class DecodeView : public std::ranges::view_interface<DecodeView<V, type>> {
+    using Common = internal::Common<type>;
+    using CharCodes = internal::CharCodes;
+    static constexpr size_t quantum_bytes = Common::quantum_bits / 8;
+    static constexpr size_t block_quanta = 64 / quantum_bytes;
+
+  public:
+    class Iterator {
+      public:
+        using iterator_concept = std::input_iterator_tag;
+        using value_type = char;
+        using difference_type = std::ptrdiff_t;
+
+        Iterator() = default;
+        Iterator(DecodeView* parent, std::ranges::iterator_t<V> current)
+            : parent(parent), current(std::move(current)) {
+            fill();
+        }
+
+        char operator*() const {
+            return block[pos];
+        }
+        Iterator& operator++() {
+            if (++pos == len)
+                fill();
+            return *this;
+        }
+        void operator++(int) {
+            ++*this;
+        }
+        friend bool operator==(const Iterator& it, std::default_sentinel_t) {
+            return it.len == 0;
+        }
+
+      private:
+        DecodeView* parent = nullptr;
+        std::ranges::iterator_t<V> current;
+        std::array<char, block_quanta * quantum_bytes> block;
+        uint8_t pos = 0;
+        uint8_t len = 0;
+        bool padded = false;
+
+        void fill() {
+            const auto end = std::ranges::end(parent->base);
+            pos = 0;
+            len = 0;
+
+            if constexpr (contiguous<V>) {
+                const size_t quanta = internal::decodeQuanta<type>(
+                    reinterpret_cast<const char*>(std::to_address(current)),
+                    std::min<size_t>((end - current) / Common::quantum_symbols,
+                                     block_quanta),
+                    block.data());
+                if (quanta > 0) {
+                    current += quanta * Common::quantum_symbols;
+                    len = quanta * quantum_bytes;
+                    return;
+                }
+            }
+
+            // Pull up to a quantum of symbols, then make sure a padded
+            // quantum is only followed by ignored characters
+            uint64_t buffer = 0;
+            size_t num_symbols = 0, padding = 0;
+            for (; current != end; ++current) {
+                const char byte =
+                    Common::inverse[static_cast<unsigned char>(*current)];
+                if (byte == static_cast<char>(CharCodes::Ignore))
+                    continue;
+                if (num_symbols + padding == Common::quantum_symbols) {
+                    if (padding == 0)
+                        break;
+                    throw std::runtime_error(
+                        byte == static_cast<char>(CharCodes::Padding)
+                            ? "Too much padding"
+                            : "Invalid padding");
+                }
+                if (byte == static_cast<char>(CharCodes::Padding)) {
+                    padding += 1;
+                    continue;
+                }
+                if (padding > 0 || padded)
+                    throw std::runtime_error("Invalid padding");
+                if (!Common::validByte(byte))
+                    throw std::runtime_error("Invalid symbol");
+                buffer = (buffer << Common::shift) | byte;
+                num_symbols += 1;
+            }
+            if (num_symbols + padding == 0)
+                return;
+
+            if (padding >= Common::quantum_symbols)
+                throw std::runtime_error("Too much padding");
+            if (num_symbols + padding != Common::quantum_symbols)
+                throw std::runtime_error("Bad input width");
+            const size_t num_bits = num_symbols * Common::shift;
+            const size_t extra_bits = num_bits % 8;
+            if (buffer & ((1 << extra_bits) - 1))
+                throw std::runtime_error("Bad encoding");
+            if (extra_bits >= Common::shift)
+                throw std::runtime_error("Invalid padding");
+
+            padded = padding > 0;
+            len = num_bits / 8;
+            for (size_t i = 0; i < len; ++i)
+                block[i] = buffer >> (extra_bits + (len - 1 - i) * 8);
+        }
+    };
+
+    DecodeView() = default;
+    explicit DecodeView(V base) : base(std::move(base)) {
+    }
+
+    Iterator begin() {
+        return Iterator(this, std::ranges::begin(base));
+    }
+    std::default_sentinel_t end() const {
+        return {};
+    }
+
+  private:
+    V base;
+};
+
+template <template <typename, EncodingType> typename View, EncodingType type>
+struct Adaptor {
+    template <std::ranges::viewable_range R>
+    auto operator()(R&& range) const {
+        return View<std::views::all_t<R>, type>(
+            std::views::all(std::forward<R>(range)));
+    }
+
+    template <std::ranges::viewable_range R>
+    friend auto operator|(R&& range, const Adaptor& adaptor) {
+        return adaptor(std::forward<R>(range));
+    }
+};
+
+template <EncodingType type>
+inline constexpr Adaptor<EncodeView, type> encode{};
+
+template <EncodingType type>
+inline constexpr Adaptor<DecodeView, type> decode{};
+
+}  // namespace textencode::views
+
+#endif
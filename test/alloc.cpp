@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <textencode/alloc.hpp>
+#include <textencode/fd.hpp>
+#include <textencode/map.hpp>
+#include <textencode/nix.hpp>
+
+#include "common.hpp"
+
+namespace textencode {
+
+namespace {
+
+constexpr uint64_t mib = 1 << 20;
+
+// Upper bounds on the heap use of transcode() to and from binary, scaled to
+// a MiB of binary data. Streaming conversions stay within a few read
+// buffers, while nix32 and base58 hold the whole input.
+struct Budget {
+    EncodingType type;
+    // Base58 is measured on less data, its conversion being slow
+    size_t size;
+    uint64_t encode_allocations;
+    uint64_t decode_allocations;
+    uint64_t peak_bytes;
+};
+
+const Budget budgets[] = {
+    {EncodingType::Binary, mib, 1024, 1024, 32 << 10},
+    {EncodingType::Base16, mib, 1024, 2048, 32 << 10},
+    {EncodingType::Base32, mib, 1024, 1600, 32 << 10},
+    {EncodingType::Nix32, mib, 1024, 1024, 9 * mib / 2},
+    {EncodingType::Base64, mib, 1024, 1400, 32 << 10},
+    {EncodingType::Ascii85, mib, 1024, 1300, 32 << 10},
+    {EncodingType::Z85, mib, 1024, 1300, 32 << 10},
+    {EncodingType::Base58, 64 << 10, 1200000, 1000000, 14 * mib},
+};
+
+uint64_t perMiB(uint64_t value, size_t size, bool streaming) {
+    return streaming ? value : value * mib / size;
+}
+
+}  // namespace
+
+TEST(AllocTest, Scope) {
+    if (!allocStatsEnabled())
+        GTEST_SKIP() << "Built without --enable-alloc-stats";
+
+    AllocScope outer;
+    auto kept = std::make_unique<char[]>(1000);
+    {
+        AllocScope inner;
+        std::make_unique<char[]>(5000);
+        const AllocStats stats = inner.stats();
+        EXPECT_EQ(1, stats.allocations);
+        EXPECT_EQ(5000, stats.bytes);
+        EXPECT_EQ(5000, stats.peak_bytes);
+    }
+    const AllocStats stats = outer.stats();
+    EXPECT_EQ(2, stats.allocations);
+    EXPECT_EQ(6000, stats.bytes);
+    EXPECT_EQ(6000, stats.peak_bytes);
+}
+
+TEST(AllocTest, CountedConverter) {
+    const std::string data = testData(1000);
+    CountedConverter encoder(to_binary.at(EncodingType::Nix32)());
+    EXPECT_EQ("", encoder.process(data));
+    const std::string encoded = encoder.complete();
+    EXPECT_EQ(encode_trivial<ToNix32>(data), encoded);
+
+    if (!allocStatsEnabled())
+        return;
+    // The buffered input and the output
+    EXPECT_LE(2, encoder.stats().allocations);
+    EXPECT_LE(data.size() + encoded.size(), encoder.stats().bytes);
+    EXPECT_LE(encoded.size(), encoder.stats().peak_bytes);
+}
+
+TEST(AllocTest, TranscodeBudget) {
+    if (!allocStatsEnabled())
+        GTEST_SKIP() << "Built without --enable-alloc-stats";
+
+    for (const auto& budget : budgets) {
+        const std::string data = testData(budget.size);
+        const bool streaming = budget.type != EncodingType::Nix32 &&
+                               budget.type != EncodingType::Base58;
+        TempFile binary, encoded, decoded;
+        binary.write(data);
+
+        AllocStats encode, decode;
+        {
+            AllocScope scope;
+            transcode(binary.fd(), EncodingType::Binary, encoded.fd(),
+                      budget.type);
+            encode = scope.stats();
+        }
+        lseek(encoded.fd(), 0, SEEK_SET);
+        {
+            AllocScope scope;
+            transcode(encoded.fd(), budget.type, decoded.fd(),
+                      EncodingType::Binary);
+            decode = scope.stats();
+        }
+        ASSERT_EQ(data, decoded.contents());
+
+        const int type = static_cast<int>(budget.type);
+        EXPECT_GE(budget.encode_allocations,
+                  perMiB(encode.allocations, budget.size, false))
+            << type;
+        EXPECT_GE(budget.decode_allocations,
+                  perMiB(decode.allocations, budget.size, false))
+            << type;
+        EXPECT_GE(budget.peak_bytes,
+                  perMiB(encode.peak_bytes, budget.size, streaming))
+            << type;
+        EXPECT_GE(budget.peak_bytes,
+                  perMiB(decode.peak_bytes, budget.size, streaming))
+            << type;
+    }
+}
+
+}  // namespace textencode
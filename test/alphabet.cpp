@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <textencode/alphabet.hpp>
+#include <textencode/base_n.hpp>
+
+#include "common.hpp"
+
+namespace textencode {
+
+namespace {
+
+const std::string base32hex = "0123456789ABCDEFGHIJKLMNOPQRSTUV";
+const std::string base64url =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+std::string encode(const Alphabet& alphabet, std::string_view data,
+                   size_t chunk = 1 << 20) {
+    ToCustomBaseN c(alphabet);
+    std::string ret;
+    for (size_t i = 0; i < data.size(); i += chunk)
+        ret += c.process(data.substr(i, chunk));
+    return ret + c.complete();
+}
+
+std::string decode(const Alphabet& alphabet, std::string_view data,
+                   size_t chunk = 1 << 20) {
+    FromCustomBaseN c(alphabet);
+    std::string ret;
+    for (size_t i = 0; i < data.size(); i += chunk)
+        ret += c.process(data.substr(i, chunk));
+    return ret + c.complete();
+}
+
+}  // namespace
+
+TEST(AlphabetTest, Properties) {
+    const Alphabet alphabet(base32hex);
+    EXPECT_EQ(base32hex, alphabet.symbols());
+    EXPECT_EQ(5, alphabet.shift());
+    EXPECT_EQ(40, alphabet.quantumBits());
+    EXPECT_EQ(8, alphabet.quantumSymbols());
+    EXPECT_EQ(10, alphabet.inverse()['A']);
+    EXPECT_EQ(10, alphabet.inverse()['a']);
+    EXPECT_EQ(static_cast<char>(-1), alphabet.inverse()['W']);
+}
+
+TEST(AlphabetTest, Invalid) {
+    EXPECT_THROW(Alphabet("abc"), std::invalid_argument);
+    EXPECT_THROW(Alphabet("a"), std::invalid_argument);
+    EXPECT_THROW(Alphabet(std::string(128, 'a')), std::invalid_argument);
+    EXPECT_THROW(Alphabet("abca"), std::invalid_argument);
+    EXPECT_THROW(Alphabet("ab=c"), std::invalid_argument);
+    EXPECT_THROW(Alphabet("ab c"), std::invalid_argument);
+    EXPECT_THROW(Alphabet("ab\nc"), std::invalid_argument);
+    EXPECT_THROW(Alphabet::standard(EncodingType::Nix32),
+                 std::invalid_argument);
+}
+
+TEST(AlphabetTest, Standard) {
+    const std::string data = testData(1000);
+    const Alphabet base64 = Alphabet::standard(EncodingType::Base64);
+    const Alphabet base32 = Alphabet::standard(EncodingType::Base32);
+    const Alphabet base16 = Alphabet::standard(EncodingType::Base16);
+    for (size_t size = 0; size < 12; ++size) {
+        const std::string_view prefix = std::string_view(data).substr(0, size);
+        EXPECT_EQ(encode_trivial<ToBase64>(prefix), encode(base64, prefix));
+        EXPECT_EQ(encode_trivial<ToBase32>(prefix), encode(base32, prefix));
+        EXPECT_EQ(encode_trivial<ToBase16>(prefix), encode(base16, prefix));
+    }
+    for (size_t chunk : {1, 2, 3, 7, 1000}) {
+        const std::string encoded = encode_trivial<ToBase32>(data);
+        EXPECT_EQ(encoded, encode(base32, data, chunk));
+        EXPECT_EQ(data, decode(base32, encoded, chunk));
+    }
+}
+
+TEST(AlphabetTest, Base32Hex) {
+    // RFC 4648 test vectors
+    const Alphabet alphabet(base32hex);
+    EXPECT_EQ("CO======", encode(alphabet, "f"));
+    EXPECT_EQ("CPNG====", encode(alphabet, "fo"));
+    EXPECT_EQ("CPNMU===", encode(alphabet, "foo"));
+    EXPECT_EQ("CPNMUOG=", encode(alphabet, "foob"));
+    EXPECT_EQ("CPNMUOJ1", encode(alphabet, "fooba"));
+    EXPECT_EQ("CPNMUOJ1E8======", encode(alphabet, "foobar"));
+    EXPECT_EQ("foobar", decode(alphabet, "cpnmuoj1e8======"));
+    EXPECT_EQ("foobar", decode(alphabet, "CPNM\nUOJ1\r\nE8======"));
+}
+
+TEST(AlphabetTest, Base64Url) {
+    const Alphabet alphabet(base64url);
+    const std::string data = "\xfb\xff\xbf";
+    EXPECT_EQ("-_-_", encode(alphabet, data));
+    EXPECT_EQ(data, decode(alphabet, "-_-_"));
+    EXPECT_THROW(decode(alphabet, "+/+/"), std::runtime_error);
+}
+
+TEST(AlphabetTest, BadInput) {
+    const Alphabet alphabet = Alphabet::standard(EncodingType::Base64);
+    for (const char* bad : {"Zm9", "Zh==", "Z===", "Zg==Zg==", "Zm9v====",
+                            "Zg=a", "Zm9*"}) {
+        EXPECT_THROW(encode_trivial<FromBase64>(bad), std::runtime_error);
+        EXPECT_THROW(decode(alphabet, bad), std::runtime_error) << bad;
+    }
+}
+
+TEST(AlphabetTest, Snapshot) {
+    const Alphabet alphabet(base32hex);
+    const std::string data = testData(23);
+    const std::string encoded = encode(alphabet, data);
+    for (size_t split = 0; split <= encoded.size(); ++split) {
+        ToCustomBaseN to(alphabet), to_resumed(alphabet);
+        FromCustomBaseN from(alphabet), from_resumed(alphabet);
+        const size_t data_split = std::min(split, data.size());
+        std::string to_out = to.process(data.substr(0, data_split));
+        std::string from_out = from.process(encoded.substr(0, split));
+        to_resumed.restore(to.snapshot());
+        from_resumed.restore(from.snapshot());
+        to_out += to_resumed.process(data.substr(data_split));
+        from_out += from_resumed.process(encoded.substr(split));
+        EXPECT_EQ(encoded, to_out + to_resumed.complete());
+        EXPECT_EQ(data, from_out + from_resumed.complete());
+    }
+}
+
+TEST(AlphabetTest, Reset) {
+    const Alphabet alphabet(base32hex);
+    const std::string data = testData(23);
+    const std::string encoded = encode(alphabet, data);
+    ToCustomBaseN to(alphabet);
+    FromCustomBaseN from(alphabet);
+    to.process(data.substr(0, 3));
+    from.process(encoded.substr(0, 5) + "=");
+    to.reset();
+    from.reset();
+    std::string to_out = to.process(data);
+    std::string from_out = from.process(encoded);
+    EXPECT_EQ(encoded, to_out + to.complete());
+    EXPECT_EQ(data, from_out + from.complete());
+}
+
+}  // namespace textencode
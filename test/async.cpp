@@ -0,0 +1,293 @@
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <textencode/async.hpp>
+#include <textencode/base_n.hpp>
+#include <textencode/map.hpp>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common.hpp"
+
+namespace textencode {
+
+using Status = AsyncTranscoder::Status;
+
+class Pipe {
+  public:
+    Pipe() {
+        EXPECT_EQ(0, pipe2(fds, O_NONBLOCK | O_CLOEXEC));
+    }
+    ~Pipe() {
+        closeRead();
+        closeWrite();
+    }
+    Pipe(const Pipe&) = delete;
+    Pipe& operator=(const Pipe&) = delete;
+
+    int read() const {
+        return fds[0];
+    }
+    int write() const {
+        return fds[1];
+    }
+    void closeRead() {
+        if (fds[0] >= 0)
+            close(std::exchange(fds[0], -1));
+    }
+    void closeWrite() {
+        if (fds[1] >= 0)
+            close(std::exchange(fds[1], -1));
+    }
+
+  private:
+    int fds[2];
+};
+
+// Runs one shot callbacks as their fds become ready
+class Reactor {
+  public:
+    Reactor() : epoll(epoll_create1(EPOLL_CLOEXEC)) {
+    }
+    ~Reactor() {
+        close(epoll);
+    }
+
+    void once(int fd, uint32_t events, std::function<void()> callback) {
+        epoll_event event{};
+        event.events = events | EPOLLONESHOT;
+        event.data.fd = fd;
+        if (epoll_ctl(epoll, EPOLL_CTL_MOD, fd, &event) < 0) {
+            ASSERT_EQ(0, epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event));
+        }
+        callbacks[fd] = std::move(callback);
+    }
+
+    void run() {
+        while (!callbacks.empty()) {
+            epoll_event events[16];
+            const int num = epoll_wait(epoll, events, 16, 5000);
+            ASSERT_GT(num, 0);
+            for (int i = 0; i < num; ++i) {
+                auto callback = std::move(callbacks.at(events[i].data.fd));
+                callbacks.erase(events[i].data.fd);
+                callback();
+            }
+        }
+    }
+
+  private:
+    int epoll;
+    std::unordered_map<int, std::function<void()>> callbacks;
+};
+
+// Writes data to pipe as it drains, closing it at the end
+void feed(Reactor& reactor, Pipe& pipe, const std::string& data,
+          size_t offset = 0) {
+    while (offset < data.size()) {
+        const ssize_t ret = ::write(pipe.write(), data.data() + offset,
+                                    data.size() - offset);
+        if (ret < 0) {
+            ASSERT_EQ(EAGAIN, errno);
+            reactor.once(pipe.write(), EPOLLOUT, [&, offset]() {
+                feed(reactor, pipe, data, offset);
+            });
+            return;
+        }
+        offset += ret;
+    }
+    pipe.closeWrite();
+}
+
+// Reads pipe into out until it's closed
+void drain(Reactor& reactor, Pipe& pipe, std::string& out) {
+    char buffer[4096];
+    for (;;) {
+        const ssize_t ret = ::read(pipe.read(), buffer, sizeof(buffer));
+        if (ret < 0) {
+            ASSERT_EQ(EAGAIN, errno);
+            reactor.once(pipe.read(), EPOLLIN,
+                         [&]() { drain(reactor, pipe, out); });
+            return;
+        }
+        if (ret == 0)
+            return;
+        out.append(buffer, ret);
+    }
+}
+
+TEST(AsyncTest, Steps) {
+    Pipe in, out;
+    AsyncTranscoder transcoder(in.read(), EncodingType::Base64, out.write(),
+                               EncodingType::Base16);
+    EXPECT_EQ(Status::WantRead, transcoder.status());
+    EXPECT_EQ(Status::WantRead, transcoder.step());
+
+    ASSERT_EQ(4, ::write(in.write(), "Zm9v", 4));
+    EXPECT_EQ(Status::WantRead, transcoder.step());
+    ASSERT_EQ(4, ::write(in.write(), "YmFy", 4));
+    in.closeWrite();
+    EXPECT_EQ(Status::Done, transcoder.step());
+    EXPECT_EQ(Status::Done, transcoder.step());
+
+    char buffer[64];
+    const ssize_t ret = ::read(out.read(), buffer, sizeof(buffer));
+    EXPECT_EQ("666F6F626172", std::string(buffer, ret > 0 ? ret : 0));
+}
+
+TEST(AsyncTest, ZeroReadSize) {
+    Pipe in, out;
+    EXPECT_THROW(
+        AsyncTranscoder(in.read(), from_binary.at(EncodingType::Binary)(),
+                        out.write(), to_binary.at(EncodingType::Base16)(), 0),
+        std::invalid_argument);
+}
+
+TEST(AsyncTest, WantWrite) {
+    // More output than a pipe holds, which isn't read until the transcoder
+    // has to wait for it
+    const std::string data = testData(1 << 20);
+    Pipe in, out;
+    Reactor reactor;
+    feed(reactor, in, data);
+
+    AsyncTranscoder transcoder(in.read(), EncodingType::Binary, out.write(),
+                               EncodingType::Base16);
+    std::string result;
+    bool draining = false;
+    std::function<void()> step = [&]() {
+        const Status status = transcoder.step();
+        if (status == Status::WantRead) {
+            reactor.once(in.read(), EPOLLIN, step);
+        } else if (status == Status::WantWrite) {
+            if (!draining)
+                drain(reactor, out, result);
+            draining = true;
+            reactor.once(out.write(), EPOLLOUT, step);
+        } else {
+            out.closeWrite();
+        }
+    };
+    step();
+    reactor.run();
+    EXPECT_TRUE(draining);
+    EXPECT_EQ(Status::Done, transcoder.status());
+    EXPECT_EQ(encode_trivial<ToBase16>(data), result);
+}
+
+TEST(AsyncTest, Concurrent) {
+    constexpr size_t count = 16;
+    const std::string data = testData(200000);
+    std::vector<Pipe> ins(count), outs(count);
+    std::vector<std::string> results(count);
+    std::vector<std::unique_ptr<AsyncTranscoder>> transcoders;
+    std::vector<std::function<void()>> steps(count);
+    Reactor reactor;
+
+    for (size_t i = 0; i < count; ++i) {
+        feed(reactor, ins[i], data);
+        drain(reactor, outs[i], results[i]);
+        transcoders.push_back(std::make_unique<AsyncTranscoder>(
+            ins[i].read(), EncodingType::Binary, outs[i].write(),
+            EncodingType::Base64));
+        steps[i] = [&, i]() {
+            const Status status = transcoders[i]->step();
+            if (status == Status::WantRead)
+                reactor.once(ins[i].read(), EPOLLIN, steps[i]);
+            else if (status == Status::WantWrite)
+                reactor.once(outs[i].write(), EPOLLOUT, steps[i]);
+            else
+                outs[i].closeWrite();
+        };
+        steps[i]();
+    }
+    reactor.run();
+
+    for (const auto& result : results)
+        EXPECT_EQ(encode_trivial<ToBase64>(data), result);
+}
+
+TEST(AsyncTest, Error) {
+    Pipe in, out;
+    AsyncTranscoder transcoder(in.read(), EncodingType::Base64, out.write(),
+                               EncodingType::Binary);
+    ASSERT_EQ(3, ::write(in.write(), "Zm9", 3));
+    in.closeWrite();
+    EXPECT_THROW(transcoder.step(), std::runtime_error);
+}
+
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+
+struct Ready {
+    Reactor& reactor;
+    int fd;
+    uint32_t events;
+
+    bool await_ready() const {
+        return false;
+    }
+    void await_suspend(std::coroutine_handle<> handle) {
+        reactor.once(fd, events, [handle]() { handle.resume(); });
+    }
+    void await_resume() const {
+    }
+};
+
+AsyncTask transcodeAndClose(Reactor& reactor, Pipe& in, Pipe& out,
+                            EncodingType from, EncodingType to) {
+    auto wait = [&](int fd, Status status) {
+        return Ready{reactor, fd,
+                     status == Status::WantRead ? EPOLLIN : EPOLLOUT};
+    };
+    co_await transcodeAsync(
+        AsyncTranscoder(in.read(), from, out.write(), to), wait);
+    out.closeWrite();
+}
+
+TEST(AsyncTest, Coroutine) {
+    constexpr size_t count = 8;
+    const std::string data = testData(300000);
+    std::vector<Pipe> ins(count), outs(count);
+    std::vector<std::string> results(count);
+    std::vector<AsyncTask> tasks;
+    Reactor reactor;
+
+    for (size_t i = 0; i < count; ++i) {
+        feed(reactor, ins[i], data);
+        drain(reactor, outs[i], results[i]);
+        tasks.push_back(transcodeAndClose(reactor, ins[i], outs[i],
+                                          EncodingType::Binary,
+                                          EncodingType::Base32));
+        tasks.back().start();
+    }
+    reactor.run();
+
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_TRUE(tasks[i].done());
+        tasks[i].result();
+        EXPECT_EQ(encode_trivial<ToBase32>(data), results[i]);
+    }
+}
+
+TEST(AsyncTest, CoroutineError) {
+    Pipe in, out;
+    Reactor reactor;
+    ASSERT_EQ(3, ::write(in.write(), "Zm9", 3));
+    in.closeWrite();
+    AsyncTask task = transcodeAndClose(reactor, in, out, EncodingType::Base64,
+                                       EncodingType::Binary);
+    task.start();
+    EXPECT_TRUE(task.done());
+    EXPECT_THROW(task.result(), std::runtime_error);
+}
+
+#endif
+
+}  // namespace textencode
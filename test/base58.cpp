@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <textencode/base58.hpp>
+#include <textencode/base_n.hpp>
+
+#include "common.hpp"
+
+namespace textencode {
+
+namespace {
+
+constexpr std::string_view alphabet =
+    "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+// The naive quadratic conversion, one input byte at a time
+std::string referenceEncode(std::string_view data) {
+    std::string digits;
+    for (const char byte : data) {
+        int carry = byte & 0xff;
+        for (auto& digit : digits) {
+            carry += (digit & 0xff) * 256;
+            digit = carry % 58;
+            carry /= 58;
+        }
+        for (; carry > 0; carry /= 58)
+            digits += static_cast<char>(carry % 58);
+    }
+    for (size_t i = 0; i < data.size() && data[i] == 0; ++i)
+        digits += '\0';
+
+    std::string ret;
+    for (auto it = digits.rbegin(); it != digits.rend(); ++it)
+        ret += alphabet[*it];
+    return ret;
+}
+
+}  // namespace
+
+TEST(Base58Test, NoInput) {
+    EXPECT_EQ("", encode_trivial<ToBase58>(""));
+    EXPECT_EQ("", encode_trivial<FromBase58>(""));
+}
+
+TEST(Base58Test, Encode) {
+    EXPECT_EQ("StV1DL6CwTryKyV", encode_trivial<ToBase58>("hello world"));
+    EXPECT_EQ("jpXCZedGfVQ", encode_trivial<ToBase58>(std::string(8, '\xff')));
+    const std::string address = "1NS17iag9jJgTHD1VXjvLCEnZuQ3rJDE9L";
+    const std::string hash = encode_trivial<FromBase16>(
+        "00EB15231DFCEB60925886B67D065299925915AEB172C06647");
+    EXPECT_EQ(address, encode_trivial<ToBase58>(hash));
+}
+
+TEST(Base58Test, Decode) {
+    EXPECT_EQ("hello world", encode_trivial<FromBase58>("StV1DL6CwTryKyV"));
+    EXPECT_EQ(std::string(8, '\xff'),
+              encode_trivial<FromBase58>("jpXCZedGfVQ"));
+}
+
+TEST(Base58Test, LeadingZeroes) {
+    EXPECT_EQ("1", encode_trivial<ToBase58>(std::string(1, '\0')));
+    EXPECT_EQ("112", encode_trivial<ToBase58>(std::string("\0\0\x01", 3)));
+    EXPECT_EQ(std::string("\0\0\x01", 3), encode_trivial<FromBase58>("112"));
+    EXPECT_EQ(std::string(3, '\0'), encode_trivial<FromBase58>("111"));
+}
+
+TEST(Base58Test, IgnoreCharacters) {
+    EXPECT_EQ("hello world",
+              encode_trivial<FromBase58>("StV1D\nL6CwT ryKyV\r\n"));
+}
+
+TEST(Base58Test, BadCharacters) {
+    for (const char* bad : {"0", "O", "I", "l", "+", "="})
+        EXPECT_THROW(FromBase58().process(bad), std::runtime_error);
+}
+
+TEST(Base58Test, Large) {
+    // Long enough to go through the divide and conquer conversion
+    for (size_t size : {100, 1000, 5000}) {
+        const std::string data = std::string(3, '\0') + testData(size);
+        const std::string encoded = referenceEncode(data);
+        EXPECT_EQ(encoded, encode_trivial<ToBase58>(data));
+        EXPECT_EQ(data, encode_trivial<FromBase58>(encoded));
+    }
+}
+
+TEST(Base58Test, Streaming) {
+    const std::string data = testData(300);
+    const std::string encoded = encode_trivial<ToBase58>(data);
+    ToBase58 to;
+    FromBase58 from;
+    std::string to_out, from_out;
+    for (size_t i = 0; i < data.size(); i += 7)
+        to_out += to.process(std::string_view(data).substr(i, 7));
+    for (size_t i = 0; i < encoded.size(); i += 7)
+        from_out += from.process(std::string_view(encoded).substr(i, 7));
+    EXPECT_EQ(encoded, to_out + to.complete());
+    EXPECT_EQ(data, from_out + from.complete());
+}
+
+TEST(Base58Test, Snapshot) {
+    const std::string data = std::string(2, '\0') + testData(40);
+    const std::string encoded = encode_trivial<ToBase58>(data);
+    for (size_t split : {0, 1, 3, 20, 42}) {
+        EXPECT_EQ(encoded, convert_resumed<ToBase58>(data, split));
+        EXPECT_EQ(data, convert_resumed<FromBase58>(encoded, split));
+    }
+    EXPECT_THROW(FromBase58().restore("\x3a"), std::invalid_argument);
+}
+
+TEST(Base58Test, MemoryResource) {
+    const std::string data = testData(100);
+    const std::string encoded = encode_trivial<ToBase58>(data);
+    CountingResource resource;
+    ToBase58 to(&resource);
+    FromBase58 from(&resource);
+    to.process(data);
+    from.process(encoded);
+    EXPECT_LE(data.size() + encoded.size(), resource.bytes);
+
+    CountingResource output;
+    EXPECT_EQ(encoded, std::string_view(to.complete(&output)));
+    EXPECT_EQ(data, std::string_view(from.complete(&output)));
+    EXPECT_LT(0, output.allocations);
+}
+
+}  // namespace textencode
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <textencode/base85.hpp>
+
+#include "common.hpp"
+
+namespace textencode {
+
+namespace {
+
+template <typename Converter>
+std::string chunked(std::string_view data, size_t chunk) {
+    Converter c;
+    std::string ret;
+    for (size_t i = 0; i < data.size(); i += chunk)
+        ret += c.process(data.substr(i, chunk));
+    ret += c.complete();
+    return ret;
+}
+
+}  // namespace
+
+TEST(Ascii85Test, NoInput) {
+    EXPECT_EQ("", encode_trivial<ToAscii85>(""));
+    EXPECT_EQ("", encode_trivial<FromAscii85>(""));
+}
+
+TEST(Ascii85Test, Encode) {
+    EXPECT_EQ("Ac", encode_trivial<ToAscii85>("f"));
+    EXPECT_EQ("Ao@", encode_trivial<ToAscii85>("fo"));
+    EXPECT_EQ("AoDS", encode_trivial<ToAscii85>("foo"));
+    EXPECT_EQ("AoDTs", encode_trivial<ToAscii85>("foob"));
+    EXPECT_EQ("AoDTs@/", encode_trivial<ToAscii85>("fooba"));
+    EXPECT_EQ("AoDTs@<)", encode_trivial<ToAscii85>("foobar"));
+    EXPECT_EQ("s8W-!", encode_trivial<ToAscii85>("\xff\xff\xff\xff"));
+    EXPECT_EQ("9jqo^BlbD-BleB1DJ+*+F(f,q",
+              encode_trivial<ToAscii85>("Man is distinguished"));
+}
+
+TEST(Ascii85Test, Decode) {
+    EXPECT_EQ("f", encode_trivial<FromAscii85>("Ac"));
+    EXPECT_EQ("fo", encode_trivial<FromAscii85>("Ao@"));
+    EXPECT_EQ("foo", encode_trivial<FromAscii85>("AoDS"));
+    EXPECT_EQ("foob", encode_trivial<FromAscii85>("AoDTs"));
+    EXPECT_EQ("fooba", encode_trivial<FromAscii85>("AoDTs@/"));
+    EXPECT_EQ("foobar", encode_trivial<FromAscii85>("AoDTs@<)"));
+    EXPECT_EQ("Man is distinguished",
+              encode_trivial<FromAscii85>("9jqo^BlbD-BleB1DJ+*+F(f,q"));
+}
+
+TEST(Ascii85Test, ZeroWords) {
+    using namespace std::string_literals;
+    const std::string data = "a\0\0\0\0\0\0\0\0b"s;
+    EXPECT_EQ("z", encode_trivial<ToAscii85>("\0\0\0\0"s));
+    EXPECT_EQ("!!!", encode_trivial<ToAscii85>("\0\0"s));
+    EXPECT_EQ("@/p9-z!+G", encode_trivial<ToAscii85>(data));
+    EXPECT_EQ(data, encode_trivial<FromAscii85>("@/p9-z!+G"));
+    EXPECT_EQ("\0\0\0\0\0\0\0\0"s, encode_trivial<FromAscii85>("zz"));
+}
+
+TEST(Ascii85Test, IgnoreCharacters) {
+    EXPECT_EQ("foobar", encode_trivial<FromAscii85>("Ao\nDT s@\r\n<)\n"));
+}
+
+TEST(Ascii85Test, Streaming) {
+    const std::string data = testData(1000) + std::string(12, '\0');
+    const std::string encoded = encode_trivial<ToAscii85>(data);
+    for (size_t chunk : {1, 2, 3, 5, 7, 64}) {
+        EXPECT_EQ(encoded, chunked<ToAscii85>(data, chunk));
+        EXPECT_EQ(data, chunked<FromAscii85>(encoded, chunk));
+    }
+}
+
+TEST(Ascii85Test, BadInput) {
+    EXPECT_THROW(encode_trivial<FromAscii85>("AoDTv"), std::runtime_error);
+    EXPECT_THROW(encode_trivial<FromAscii85>("Ao~Ts"), std::runtime_error);
+    EXPECT_THROW(encode_trivial<FromAscii85>("AozTs"), std::runtime_error);
+    EXPECT_THROW(encode_trivial<FromAscii85>("s8W-\""), std::runtime_error);
+    EXPECT_THROW(encode_trivial<FromAscii85>("AoDTsA"), std::runtime_error);
+    EXPECT_THROW(encode_trivial<FromAscii85>("uuu"), std::runtime_error);
+}
+
+TEST(Z85Test, Spec) {
+    const std::string data = "\x86\x4F\xD2\x6F\xB5\x59\xF7\x5B";
+    EXPECT_EQ("HelloWorld", encode_trivial<ToZ85>(data));
+    EXPECT_EQ(data, encode_trivial<FromZ85>("HelloWorld"));
+}
+
+TEST(Z85Test, NoZeroWords) {
+    EXPECT_EQ("00000", encode_trivial<ToZ85>(std::string(4, '\0')));
+    EXPECT_EQ(std::string(4, '\0'), encode_trivial<FromZ85>("00000"));
+    // 'z' is an ordinary symbol here
+    EXPECT_EQ(std::string("\0\x03\xe7\x8d", 4), encode_trivial<FromZ85>("00zzz"));
+}
+
+TEST(Z85Test, PartialWords) {
+    for (size_t size = 0; size < 12; ++size) {
+        const std::string data = testData(size);
+        const std::string encoded = encode_trivial<ToZ85>(data);
+        EXPECT_EQ(size + (size + 3) / 4, encoded.size());
+        EXPECT_EQ(data, encode_trivial<FromZ85>(encoded));
+    }
+}
+
+TEST(Z85Test, Streaming) {
+    const std::string data = testData(1001);
+    const std::string encoded = encode_trivial<ToZ85>(data);
+    for (size_t chunk : {1, 4, 6, 64}) {
+        EXPECT_EQ(encoded, chunked<ToZ85>(data, chunk));
+        EXPECT_EQ(data, chunked<FromZ85>(encoded, chunk));
+    }
+}
+
+TEST(Z85Test, BadInput) {
+    EXPECT_THROW(encode_trivial<FromZ85>("Hello~orld"), std::runtime_error);
+    EXPECT_THROW(encode_trivial<FromZ85>("%nSc1"), std::runtime_error);
+    EXPECT_THROW(encode_trivial<FromZ85>("HelloW"), std::runtime_error);
+}
+
+TEST(Ascii85Test, Snapshot) {
+    const std::string data = testData(30) + std::string(8, '\0');
+    const std::string encoded = encode_trivial<ToAscii85>(data);
+    for (size_t split = 0; split <= data.size(); ++split)
+        EXPECT_EQ(encoded, convert_resumed<ToAscii85>(data, split));
+    for (size_t split = 0; split <= encoded.size(); ++split)
+        EXPECT_EQ(data, convert_resumed<FromAscii85>(encoded, split));
+    // 4 symbols can't be more than 85^4 - 1
+    EXPECT_THROW(FromAscii85().restore("\x04\xb1\x89\xf2\x18"),
+                 std::invalid_argument);
+}
+
+TEST(Z85Test, Snapshot) {
+    const std::string data = testData(31);
+    const std::string encoded = encode_trivial<ToZ85>(data);
+    for (size_t split = 0; split <= data.size(); ++split)
+        EXPECT_EQ(encoded, convert_resumed<ToZ85>(data, split));
+    for (size_t split = 0; split <= encoded.size(); ++split)
+        EXPECT_EQ(data, convert_resumed<FromZ85>(encoded, split));
+    EXPECT_THROW(ToZ85().restore(std::string("\x04\0", 2)),
+                 std::invalid_argument);
+}
+
+}  // namespace textencode
@@ -7,6 +7,12 @@
 
 namespace textencode {
 
+template <typename Decoder>
+std::string decodeInPlace(std::string data) {
+    data.resize(Decoder::decodeInPlace(data.data(), data.size()));
+    return data;
+}
+
 TEST(Base16Test, NoInputTo) {
     EXPECT_EQ("", ToBase16().complete());
     EXPECT_EQ("", encode_trivial<ToBase16>(""));
@@ -81,6 +87,7 @@ TEST(Base16Test, BadCharacters) {
     EXPECT_THROW(FromBase16().process("Z"), std::runtime_error);
     EXPECT_THROW(FromBase16().process("g"), std::runtime_error);
     EXPECT_THROW(FromBase16().process("+"), std::runtime_error);
+    EXPECT_THROW(FromBase16().process("\xff\x80"), std::runtime_error);
 }
 
 TEST(Base16Test, BadPadding) {
@@ -92,6 +99,14 @@ TEST(Base16Test, BadPadding) {
     EXPECT_THROW(encode_trivial<FromBase16>("abcd=="), std::runtime_error);
 }
 
+TEST(Base16Test, InPlace) {
+    EXPECT_EQ("", decodeInPlace<FromBase16>(""));
+    EXPECT_EQ("foobar", decodeInPlace<FromBase16>("666F6f626172"));
+    EXPECT_EQ("\xA7\xDE\xF6", decodeInPlace<FromBase16>("a7\nd\r ef6\n"));
+    EXPECT_THROW(decodeInPlace<FromBase16>("AbCde"), std::runtime_error);
+    EXPECT_THROW(decodeInPlace<FromBase16>("g0"), std::runtime_error);
+}
+
 TEST(Base32Test, NoInputTo) {
     EXPECT_EQ("", ToBase32().complete());
     EXPECT_EQ("", encode_trivial<ToBase32>(""));
@@ -172,6 +187,7 @@ TEST(Base32Test, BadCharacters) {
     EXPECT_THROW(FromBase32().process("1"), std::runtime_error);
     EXPECT_THROW(FromBase32().process("9"), std::runtime_error);
     EXPECT_THROW(FromBase32().process("+"), std::runtime_error);
+    EXPECT_THROW(FromBase32().process("\xff\x80"), std::runtime_error);
 }
 
 TEST(Base32Test, BadPaddingInline) {
@@ -200,6 +216,15 @@ TEST(Base32Test, BadZeroEncoding) {
     EXPECT_THROW(encode_trivial<FromBase32>("MZxW6YU="), std::runtime_error);
 }
 
+TEST(Base32Test, InPlace) {
+    EXPECT_EQ("", decodeInPlace<FromBase32>(""));
+    EXPECT_EQ("f", decodeInPlace<FromBase32>("MY======"));
+    EXPECT_EQ("foobar", decodeInPlace<FromBase32>("MZXW6YTBOI======"));
+    EXPECT_EQ("foo", decodeInPlace<FromBase32>("Mz\nX W6 \r= ==\n"));
+    EXPECT_THROW(decodeInPlace<FromBase32>("MZXW=6=="), std::runtime_error);
+    EXPECT_THROW(decodeInPlace<FromBase32>("MZXW7==="), std::runtime_error);
+}
+
 TEST(Base64Test, NoInputTo) {
     EXPECT_EQ("", ToBase64().complete());
     EXPECT_EQ("", encode_trivial<ToBase64>(""));
@@ -279,6 +304,7 @@ TEST(Base64Test, BadShortInput) {
 TEST(Base64Test, BadCharacters) {
     EXPECT_THROW(FromBase64().process("-"), std::runtime_error);
     EXPECT_THROW(FromBase64().process("_"), std::runtime_error);
+    EXPECT_THROW(FromBase64().process("\xff\x80"), std::runtime_error);
 }
 
 TEST(Base64Test, BadPaddingInline) {
@@ -305,4 +331,44 @@ TEST(Base64Test, BadZeroEncoding) {
     EXPECT_THROW(encode_trivial<FromBase64>("Zm+="), std::runtime_error);
 }
 
+TEST(Base64Test, InPlace) {
+    EXPECT_EQ("", decodeInPlace<FromBase64>(""));
+    EXPECT_EQ("fo", decodeInPlace<FromBase64>("Zm8="));
+    EXPECT_EQ("foobar", decodeInPlace<FromBase64>("Zm9vYmFy"));
+    EXPECT_THROW(decodeInPlace<FromBase64>("Zm9vY"), std::runtime_error);
+    EXPECT_THROW(decodeInPlace<FromBase64>("Zm9="), std::runtime_error);
+
+    const std::string data = testData(1000);
+    EXPECT_EQ(data, decodeInPlace<FromBase64>(encode_trivial<ToBase64>(data)));
+}
+
+TEST(Base64Test, Snapshot) {
+    const std::string data = testData(20);
+    const std::string encoded = encode_trivial<ToBase64>(data) + "\n";
+    for (size_t split = 0; split <= data.size(); ++split)
+        EXPECT_EQ(encoded.substr(0, encoded.size() - 1),
+                  convert_resumed<ToBase64>(data, split));
+    for (size_t split = 0; split <= encoded.size(); ++split)
+        EXPECT_EQ(data, convert_resumed<FromBase64>(encoded, split));
+    EXPECT_EQ("foo", convert_resumed<FromBase32>("MZXW6===", 7));
+    EXPECT_EQ("666F6F", convert_resumed<ToBase16>("foo", 1));
+}
+
+TEST(Base64Test, BadSnapshot) {
+    // A fresh converter's state is two zeroes, bits and buffer
+    EXPECT_EQ(std::string(2, '\0'), ToBase64().snapshot());
+    EXPECT_THROW(ToBase64().restore(""), std::invalid_argument);
+    EXPECT_THROW(ToBase64().restore(std::string(3, '\0')),
+                 std::invalid_argument);
+    // 4 bits aren't a whole byte, and 32 more than a quantum
+    EXPECT_THROW(ToBase64().restore(std::string("\x04\0", 2)),
+                 std::invalid_argument);
+    EXPECT_THROW(ToBase64().restore(std::string("\x20\0", 2)),
+                 std::invalid_argument);
+    // 8 bits with a 9 bit buffer
+    EXPECT_THROW(ToBase64().restore("\x08\x80\x02"), std::invalid_argument);
+    EXPECT_THROW(FromBase64().restore(std::string("\x08\0\0", 3)),
+                 std::invalid_argument);
+}
+
 }  // namespace textencode
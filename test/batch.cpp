@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <textencode/base_n.hpp>
+#include <textencode/batch.hpp>
+#include <textencode/map.hpp>
+#include <utility>
+#include <vector>
+
+#include "common.hpp"
+
+namespace textencode {
+
+class BatchTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        char path[] = "/tmp/textencode-batch-XXXXXX";
+        ASSERT_NE(nullptr, mkdtemp(path));
+        dir = path;
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir);
+    }
+
+    std::string file(const std::string& name, const std::string& data) {
+        const std::string path = dir + "/" + name;
+        std::ofstream(path, std::ios::binary) << data;
+        return path;
+    }
+
+    static std::string contents(const std::string& path) {
+        std::ostringstream ret;
+        ret << std::ifstream(path, std::ios::binary).rdbuf();
+        return ret.str();
+    }
+
+    std::string dir;
+};
+
+TEST_F(BatchTest, Splittable) {
+    EXPECT_TRUE(splittable(EncodingType::Binary, EncodingType::Base64));
+    EXPECT_TRUE(splittable(EncodingType::Binary, EncodingType::Z85));
+    EXPECT_FALSE(splittable(EncodingType::Binary, EncodingType::Nix32));
+    EXPECT_FALSE(splittable(EncodingType::Binary, EncodingType::Ascii85));
+    EXPECT_FALSE(splittable(EncodingType::Base64, EncodingType::Base16));
+}
+
+TEST_F(BatchTest, Files) {
+    std::vector<BatchFile> files;
+    for (size_t i = 0; i < 20; ++i) {
+        const std::string input =
+            file(std::to_string(i), std::string(i * 1000, 'a' + i));
+        files.push_back({input, input + ".b64"});
+    }
+
+    for (size_t threads = 1; threads <= 4; ++threads) {
+        const auto summary = transcodeFiles(files, EncodingType::Binary,
+                                            EncodingType::Base64, threads);
+        EXPECT_EQ(20, summary.files);
+        EXPECT_EQ(190000, summary.bytes_in);
+        EXPECT_TRUE(summary.failures.empty());
+        for (size_t i = 0; i < files.size(); ++i)
+            EXPECT_EQ(encode_trivial<ToBase64>(contents(files[i].input)),
+                      contents(files[i].output));
+    }
+}
+
+TEST_F(BatchTest, Decode) {
+    const std::string input = file("in", "Zm9vYmFy\n");
+    const auto summary = transcodeFiles({{input, input + ".out"}},
+                                        EncodingType::Base64,
+                                        EncodingType::Base16);
+    EXPECT_TRUE(summary.failures.empty());
+    EXPECT_EQ("666F6F626172", contents(input + ".out"));
+}
+
+TEST_F(BatchTest, Split) {
+    const std::string data = testData(100000);
+    const std::string input = file("in", data);
+
+    for (const auto to : {EncodingType::Binary, EncodingType::Base16,
+                          EncodingType::Base32, EncodingType::Base64,
+                          EncodingType::Z85}) {
+        auto encoder = to_binary.at(to)();
+        std::string expected = encoder->process(data);
+        expected += encoder->complete();
+        for (const size_t split_size : {0, 1000, 4097, 1 << 20}) {
+            const auto summary = transcodeFiles({{input, input + ".out"}},
+                                                EncodingType::Binary, to, 3,
+                                                split_size);
+            EXPECT_TRUE(summary.failures.empty());
+            EXPECT_EQ(data.size(), summary.bytes_in);
+            EXPECT_EQ(expected.size(), summary.bytes_out);
+            EXPECT_EQ(expected, contents(input + ".out"));
+        }
+    }
+}
+
+TEST_F(BatchTest, Failures) {
+    const std::string good = file("good", "Zm8=");
+    const std::string bad = file("bad", "Zm8");
+    const auto summary = transcodeFiles(
+        {{good, good + ".out"},
+         {bad, bad + ".out"},
+         {dir + "/missing", dir + "/missing.out"}},
+        EncodingType::Base64, EncodingType::Binary, 2);
+    EXPECT_EQ(3, summary.files);
+    ASSERT_EQ(2, summary.failures.size());
+    EXPECT_EQ(bad, summary.failures[0].path);
+    EXPECT_EQ(dir + "/missing", summary.failures[1].path);
+    EXPECT_EQ("fo", contents(good + ".out"));
+}
+
+TEST_F(BatchTest, OutputCollisions) {
+    ASSERT_EQ(0, mkdir((dir + "/a").c_str(), 0777));
+    ASSERT_EQ(0, mkdir((dir + "/b").c_str(), 0777));
+    const std::string a = file("a/x", "a");
+    const std::string b = file("b/x", "b");
+    EXPECT_THROW(transcodeFiles({{a, dir + "/x.out"}, {b, dir + "/x.out"}},
+                                EncodingType::Binary, EncodingType::Base16),
+                 std::invalid_argument);
+
+    // Another path to an output that exists, or to the input itself
+    file("y.out", "");
+    EXPECT_THROW(transcodeFiles({{a, dir + "/y.out"}, {b, dir + "/./y.out"}},
+                                EncodingType::Binary, EncodingType::Base16),
+                 std::invalid_argument);
+    EXPECT_THROW(transcodeFiles({{a, dir + "/a/./x"}}, EncodingType::Binary,
+                                EncodingType::Base16),
+                 std::invalid_argument);
+    EXPECT_EQ("a", contents(a));
+    EXPECT_EQ("", contents(dir + "/y.out"));
+}
+
+TEST_F(BatchTest, ShardRange) {
+    for (const size_t count : {1, 2, 7, 64}) {
+        // Shards tile the input, starting on quanta when splittable
+        uint64_t last = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const auto [begin, end] = shardRange(
+                1000, i, count, EncodingType::Binary, EncodingType::Base64);
+            EXPECT_EQ(last, begin);
+            EXPECT_EQ(0, begin % 3);
+            EXPECT_LE(begin, end);
+            last = end;
+        }
+        EXPECT_EQ(1000, last);
+    }
+    EXPECT_EQ(std::make_pair(uint64_t(333), uint64_t(666)),
+              shardRange(1000, 1, 3, EncodingType::Base64,
+                         EncodingType::Base16));
+    EXPECT_EQ(std::make_pair(uint64_t(332), uint64_t(664)),
+              shardRange(1000, 1, 3, EncodingType::Binary, EncodingType::Z85));
+    EXPECT_THROW(shardRange(1000, 3, 3, EncodingType::Binary,
+                            EncodingType::Base64),
+                 std::invalid_argument);
+}
+
+}  // namespace textencode
@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <textencode/column.hpp>
+#include <textencode/map.hpp>
+#include <vector>
+
+#include "common.hpp"
+
+namespace textencode {
+
+namespace {
+
+Column makeColumn(const std::vector<std::string>& values) {
+    Column ret;
+    ret.offsets.push_back(0);
+    for (const auto& value : values) {
+        ret.data += value;
+        ret.offsets.push_back(ret.data.size());
+    }
+    return ret;
+}
+
+std::vector<std::string> values(const Column& column) {
+    std::vector<std::string> ret;
+    for (size_t i = 0; i + 1 < column.offsets.size(); ++i)
+        ret.push_back(column.data.substr(
+            column.offsets[i], column.offsets[i + 1] - column.offsets[i]));
+    return ret;
+}
+
+// Values of every length up to a few quanta, with some zero words
+std::vector<std::string> testValues() {
+    std::vector<std::string> ret;
+    for (size_t size = 0; size < 40; ++size) {
+        std::string value;
+        for (size_t i = 0; i < size; ++i)
+            value += static_cast<char>(i < 8 ? 0 : size * 31 + i * 7);
+        ret.push_back(value);
+    }
+    return ret;
+}
+
+const EncodingType all_types[] = {
+    EncodingType::Binary, EncodingType::Base16,  EncodingType::Base32,
+    EncodingType::Nix32,  EncodingType::Base64,  EncodingType::Ascii85,
+    EncodingType::Z85,    EncodingType::Base58,
+};
+
+}  // namespace
+
+TEST(ColumnTest, EncodedSize) {
+    for (const auto type : all_types) {
+        for (const auto& value : testValues()) {
+            const size_t size =
+                convert(value, EncodingType::Binary, type).size();
+            if (type == EncodingType::Ascii85 || type == EncodingType::Base58)
+                EXPECT_LE(size, encodedSize(type, value.size()));
+            else
+                EXPECT_EQ(size, encodedSize(type, value.size()));
+        }
+    }
+}
+
+TEST(ColumnTest, Encode) {
+    const auto binary = testValues();
+    for (const auto type : all_types) {
+        std::vector<std::string> expected;
+        for (const auto& value : binary)
+            expected.push_back(convert(value, EncodingType::Binary, type));
+        const Column column =
+            convertColumn(makeColumn(binary), EncodingType::Binary, type);
+        EXPECT_EQ(expected, values(column));
+    }
+}
+
+TEST(ColumnTest, Decode) {
+    const auto binary = testValues();
+    for (const auto from : all_types) {
+        std::vector<std::string> encoded;
+        for (const auto& value : binary)
+            encoded.push_back(convert(value, EncodingType::Binary, from));
+        for (const auto to : {EncodingType::Binary, EncodingType::Base16,
+                              EncodingType::Ascii85}) {
+            std::vector<std::string> expected;
+            for (const auto& value : binary)
+                expected.push_back(convert(value, EncodingType::Binary, to));
+            EXPECT_EQ(expected,
+                      values(convertColumn(makeColumn(encoded), from, to)));
+        }
+    }
+}
+
+TEST(ColumnTest, Threads) {
+    std::vector<std::string> binary;
+    for (size_t i = 0; i < 1000; ++i)
+        binary.push_back(std::string(i % 50, static_cast<char>(i)));
+    const Column column = makeColumn(binary);
+    for (const auto to : {EncodingType::Base64, EncodingType::Base58}) {
+        const Column expected = convertColumn(column, EncodingType::Binary, to);
+        for (size_t threads : {2, 3, 8, 2000}) {
+            const Column ret =
+                convertColumn(column, EncodingType::Binary, to, threads);
+            EXPECT_EQ(expected.offsets, ret.offsets);
+            EXPECT_EQ(expected.data, ret.data);
+        }
+    }
+}
+
+TEST(ColumnTest, Slice) {
+    // Offsets into a larger buffer need not start at 0
+    const std::string data = "xxZm9vYmFyZg==";
+    const uint64_t offsets[] = {2, 6, 10, 14};
+    Column out;
+    convertColumn(offsets, 3, data, EncodingType::Base64,
+                  EncodingType::Base16, out);
+    EXPECT_EQ((std::vector<uint64_t>{0, 6, 12, 14}), out.offsets);
+    EXPECT_EQ("666F6F62617266", out.data);
+}
+
+TEST(ColumnTest, Empty) {
+    EXPECT_EQ(std::vector<uint64_t>{0},
+              convertColumn(Column(), EncodingType::Binary,
+                            EncodingType::Base64)
+                  .offsets);
+    const Column ret = convertColumn(makeColumn({"", ""}),
+                                     EncodingType::Base64,
+                                     EncodingType::Binary);
+    EXPECT_EQ((std::vector<uint64_t>{0, 0, 0}), ret.offsets);
+}
+
+TEST(ColumnTest, Errors) {
+    const Column column = makeColumn({"Zm9v", "Zm9", "YmFy"});
+    try {
+        convertColumn(column, EncodingType::Base64, EncodingType::Base16, 2);
+        FAIL();
+    } catch (const std::runtime_error& e) {
+        EXPECT_EQ(std::string("Value 1: Bad input width"), e.what());
+    }
+
+    const uint64_t offsets[] = {0, 4, 2};
+    Column out;
+    EXPECT_THROW(convertColumn(offsets, 2, "Zm9vYmFy", EncodingType::Base64,
+                               EncodingType::Base16, out),
+                 std::invalid_argument);
+    EXPECT_THROW(convertColumn(offsets, 1, "Zm", EncodingType::Base64,
+                               EncodingType::Base16, out),
+                 std::invalid_argument);
+}
+
+}  // namespace textencode
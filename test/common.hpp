@@ -1,11 +1,37 @@
 #pragma once
 
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstddef>
+#include <cstdio>
+#include <memory_resource>
 #include <string>
 #include <string_view>
 #include <textencode/common.hpp>
+#include <textencode/map.hpp>
 
 namespace textencode {
 
+// Bytes of every value in an irregular order, as input to round trips
+inline std::string testData(size_t size) {
+    std::string ret(size, '\0');
+    for (size_t i = 0; i < size; ++i)
+        ret[i] = static_cast<char>(i * 131 + i / 251);
+    return ret;
+}
+
+// Decodes data from one encoding and encodes the result in another, with
+// converters from the maps
+inline std::string convert(std::string_view data, EncodingType from,
+                           EncodingType to) {
+    const auto decoder = from_binary.at(from)();
+    const auto encoder = to_binary.at(to)();
+    std::string ret = encoder->process(decoder->process(data));
+    ret += encoder->process(decoder->complete());
+    ret += encoder->complete();
+    return ret;
+}
+
 template <typename Encoder>
 std::string encode_trivial(std::string_view data) {
     Encoder e;
@@ -14,4 +40,66 @@ std::string encode_trivial(std::string_view data) {
     return ret;
 }
 
+// Converts data in two parts, moving the state to a fresh converter between
+// them as a snapshot
+template <typename Converter>
+std::string convert_resumed(std::string_view data, size_t split) {
+    Converter first;
+    std::string ret = first.process(data.substr(0, split));
+    Converter second;
+    second.restore(first.snapshot());
+    ret += second.process(data.substr(split));
+    ret += second.complete();
+    return ret;
+}
+
+// Counts what is allocated through it from the default resource
+class CountingResource : public std::pmr::memory_resource {
+  public:
+    size_t allocations = 0;
+    size_t bytes = 0;
+
+  private:
+    void* do_allocate(size_t size, size_t alignment) override {
+        allocations += 1;
+        bytes += size;
+        return std::pmr::get_default_resource()->allocate(size, alignment);
+    }
+    void do_deallocate(void* p, size_t size, size_t alignment) override {
+        std::pmr::get_default_resource()->deallocate(p, size, alignment);
+    }
+    bool do_is_equal(
+        const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+class TempFile {
+  public:
+    TempFile() : file(std::tmpfile()) {
+    }
+    ~TempFile() {
+        std::fclose(file);
+    }
+
+    int fd() const {
+        return fileno(file);
+    }
+
+    void write(std::string_view data) {
+        ASSERT_EQ(data.size(), ::write(fd(), data.data(), data.size()));
+        lseek(fd(), 0, SEEK_SET);
+    }
+
+    std::string contents() const {
+        std::string ret(lseek(fd(), 0, SEEK_END), '\0');
+        lseek(fd(), 0, SEEK_SET);
+        EXPECT_EQ(ret.size(), ::read(fd(), ret.data(), ret.size()));
+        return ret;
+    }
+
+  private:
+    std::FILE* file;
+};
+
 }  // namespace textencode
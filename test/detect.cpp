@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <textencode/detect.hpp>
+#include <textencode/map.hpp>
+
+#include "common.hpp"
+
+namespace textencode {
+
+TEST(DetectTest, Encoded) {
+    const std::string data = testData(300);
+    for (const auto type :
+         {EncodingType::Base16, EncodingType::Base32, EncodingType::Nix32,
+          EncodingType::Base58, EncodingType::Base64, EncodingType::Ascii85,
+          EncodingType::Z85}) {
+        const std::string encoded = convert(data, EncodingType::Binary, type);
+        EXPECT_EQ(type, detect(encoded)) << encoded;
+        EXPECT_EQ(type, detect(encoded.substr(0, 101), true)) << encoded;
+    }
+}
+
+TEST(DetectTest, Case) {
+    EXPECT_EQ(EncodingType::Base16, detect("deadBEEF"));
+    EXPECT_EQ(EncodingType::Base32, detect("MZXW6YTBOI======"));
+    EXPECT_EQ(EncodingType::Base32, detect("mzxw6ytboi======"));
+    EXPECT_EQ(EncodingType::Nix32, detect("0000000"));
+    EXPECT_EQ(EncodingType::Nix32, detect("1B8M7WBZ"));
+}
+
+TEST(DetectTest, Whitespace) {
+    EXPECT_EQ(EncodingType::Base64, detect("Zm9v\nYmFy\r\nYg==\n"));
+    EXPECT_EQ(EncodingType::Base16, detect("66 6f 6f\n"));
+}
+
+TEST(DetectTest, Padding) {
+    EXPECT_EQ(EncodingType::Base64, detect("Zm9vYg==\n"));
+    EXPECT_NE(EncodingType::Base64, detect("Zm9vYg==Zm9v"));
+    EXPECT_NE(EncodingType::Base64, detect("Zm9vYg==="));
+}
+
+TEST(DetectTest, Length) {
+    EXPECT_NE(EncodingType::Base64, detect("Zm9v+"));
+    EXPECT_EQ(EncodingType::Base64, detect("Zm9v+", true));
+    EXPECT_NE(EncodingType::Base16, detect("666"));
+    EXPECT_EQ(EncodingType::Base16, detect("666", true));
+}
+
+TEST(DetectTest, Binary) {
+    EXPECT_EQ(EncodingType::Binary, detect(""));
+    EXPECT_EQ(EncodingType::Binary, detect(" \r\n"));
+    EXPECT_EQ(EncodingType::Binary, detect(std::string("\0\xff", 2)));
+    EXPECT_EQ(EncodingType::Binary, detect(testData(300)));
+}
+
+TEST(FromAutoTest, Streaming) {
+    const std::string data = testData(1000);
+    for (const auto type : {EncodingType::Base32, EncodingType::Base64,
+                            EncodingType::Z85}) {
+        const std::string encoded = convert(data, EncodingType::Binary, type);
+        FromAuto decoder(64);
+        std::string ret;
+        for (size_t i = 0; i < encoded.size(); i += 10) {
+            ret += decoder.process(encoded.substr(i, 10));
+            if (i + 10 < 64) {
+                EXPECT_EQ(EncodingType::Binary, decoder.type());
+            }
+        }
+        EXPECT_EQ(type, decoder.type());
+        ret += decoder.complete();
+        EXPECT_EQ(data, ret);
+    }
+}
+
+TEST(FromAutoTest, Short) {
+    FromAuto decoder;
+    EXPECT_EQ("", decoder.process("666F"));
+    EXPECT_EQ("", decoder.process("6F"));
+    EXPECT_EQ("foo", decoder.complete());
+    EXPECT_EQ(EncodingType::Base16, decoder.type());
+}
+
+TEST(FromAutoTest, Undetected) {
+    const std::string data = testData(100);
+    EXPECT_EQ(data, encode_trivial<FromAuto>(data));
+}
+
+TEST(FromAutoTest, Snapshot) {
+    const std::string data = testData(200);
+    const std::string encoded = convert(data, EncodingType::Binary, EncodingType::Base32);
+    for (const size_t split : {0, 10, 63, 64, 65, 300}) {
+        FromAuto first(64), second(64);
+        std::string ret = first.process(encoded.substr(0, split));
+        second.restore(first.snapshot());
+        ret += second.process(encoded.substr(split));
+        ret += second.complete();
+        EXPECT_EQ(data, ret);
+        EXPECT_EQ(EncodingType::Base32, second.type());
+    }
+}
+
+TEST(FromAutoTest, Reset) {
+    const std::string data = testData(200);
+    FromAuto decoder(64);
+    decoder.process(convert(data, EncodingType::Binary, EncodingType::Base32));
+    EXPECT_EQ(EncodingType::Base32, decoder.type());
+    decoder.reset();
+    EXPECT_EQ(EncodingType::Binary, decoder.type());
+
+    const std::string encoded = convert(data, EncodingType::Binary, EncodingType::Base64);
+    std::string ret = decoder.process(encoded);
+    ret += decoder.complete();
+    EXPECT_EQ(data, ret);
+    EXPECT_EQ(EncodingType::Base64, decoder.type());
+}
+
+}  // namespace textencode
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <string_view>
+#include <textencode/base_n.hpp>
+#include <textencode/digest.hpp>
+
+#include "common.hpp"
+
+namespace textencode {
+
+template <typename Digest>
+std::string hexDigest(std::string_view data) {
+    Digest d;
+    EXPECT_EQ("", d.process(data));
+    return encode_trivial<ToBase16>(d.complete());
+}
+
+TEST(Sha256Test, Empty) {
+    EXPECT_EQ(
+        "E3B0C44298FC1C149AFBF4C8996FB92427AE41E4649B934CA495991B7852B855",
+        hexDigest<Sha256>(""));
+}
+
+TEST(Sha256Test, Known) {
+    EXPECT_EQ(
+        "BA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD",
+        hexDigest<Sha256>("abc"));
+    EXPECT_EQ(
+        "248D6A61D20638B8E5C026930C3E6039A33CE45964FF2167F6ECEDD419DB06C1",
+        hexDigest<Sha256>(
+            "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"));
+}
+
+TEST(Sha256Test, Streaming) {
+    const std::string data(1000000, 'a');
+    Sha256 d;
+    for (size_t i = 0; i < data.size(); i += 37)
+        d.process(std::string_view(data).substr(i, 37));
+    EXPECT_EQ(
+        "CDC76E5C9914FB9281A1C7E284D73E67F1809A48A497200E046D39CCC7112CD0",
+        encode_trivial<ToBase16>(d.complete()));
+}
+
+TEST(Sha512Test, Empty) {
+    EXPECT_EQ(
+        "CF83E1357EEFB8BDF1542850D66D8007D620E4050B5715DC83F4A921D36CE9CE"
+        "47D0D13C5D85F2B0FF8318D2877EEC2F63B931BD47417A81A538327AF927DA3E",
+        hexDigest<Sha512>(""));
+}
+
+TEST(Sha512Test, Known) {
+    EXPECT_EQ(
+        "DDAF35A193617ABACC417349AE20413112E6FA4E89A97EA20A9EEEE64B55D39A"
+        "2192992A274FC1A836BA3C23A3FEEBBD454D4423643CE80E2A9AC94FA54CA49F",
+        hexDigest<Sha512>("abc"));
+    EXPECT_EQ(
+        "8E959B75DAE313DA8CF4F72814FC143F8F7779C6EB9F7FA17299AEADB6889018"
+        "501D289E4900F7E4331B99DEC4B5433AC7D329EEB6DD26545E96E55B874BE909",
+        hexDigest<Sha512>("abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghij"
+                          "klmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrs"
+                          "tnopqrstu"));
+}
+
+TEST(Sha512Test, Streaming) {
+    const std::string data(1000000, 'a');
+    Sha512 d;
+    for (size_t i = 0; i < data.size(); i += 131)
+        d.process(std::string_view(data).substr(i, 131));
+    EXPECT_EQ(
+        "E718483D0CE769644E2E42C7BC15B4638E1F98B13B2044285632A803AFA973EB"
+        "DE0FF244877EA60A4CB0432CE577C31BEB009C5C2C49AA2E4EADB217AD8CC09B",
+        encode_trivial<ToBase16>(d.complete()));
+}
+
+}  // namespace textencode
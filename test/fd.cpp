@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <textencode/alphabet.hpp>
+#include <textencode/base_n.hpp>
+#include <textencode/batch.hpp>
+#include <textencode/fd.hpp>
+#include <textencode/nix.hpp>
+
+#include "common.hpp"
+
+namespace textencode {
+
+TEST(FdTest, Single) {
+    TempFile in, out;
+    in.write("Zm9vYmFy");
+    transcode(in.fd(), EncodingType::Base64, out.fd(), EncodingType::Nix32);
+    EXPECT_EQ("3jc5i6yvv6", out.contents());
+}
+
+TEST(FdTest, FanOut) {
+    TempFile in, hex, base64, nix32;
+    const std::string data = std::string(5000, 'f') + "oobar";
+    in.write(data);
+    transcode(in.fd(), EncodingType::Binary,
+              {
+                  {hex.fd(), EncodingType::Base16},
+                  {base64.fd(), EncodingType::Base64},
+                  {nix32.fd(), EncodingType::Nix32},
+              });
+
+    std::string expected;
+    for (size_t i = 0; i < 5000; ++i)
+        expected += "66";
+    EXPECT_EQ(expected + "6F6F626172", hex.contents());
+    EXPECT_EQ(encode_trivial<ToBase64>(data), base64.contents());
+    EXPECT_EQ(encode_trivial<ToNix32>(data), nix32.contents());
+}
+
+TEST(FdTest, Digest) {
+    TempFile in, out, digest;
+    in.write("Zm9vYmFy");
+    transcode(in.fd(), EncodingType::Base64,
+              {
+                  {out.fd(), EncodingType::Binary},
+                  {digest.fd(), EncodingType::Nix32, DigestType::Sha256},
+              });
+    EXPECT_EQ("foobar", out.contents());
+    EXPECT_EQ("1wn4y2p4qwb07553sf7sqa9fax497imlcffx8y8avs106zqqzay3",
+              digest.contents());
+}
+
+TEST(FdTest, Alphabet) {
+    TempFile in, out;
+    in.write("vfvru===");
+    const Alphabet base32hex("0123456789ABCDEFGHIJKLMNOPQRSTUV");
+    const Alphabet base64url(
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_");
+    transcode(in.fd(), std::make_unique<FromCustomBaseN>(base32hex),
+              {{out.fd(), EncodingType::Base64, std::nullopt, base64url}});
+    EXPECT_EQ("-_-_", out.contents());
+}
+
+TEST(FdTest, NoOutputs) {
+    TempFile in;
+    in.write("666F");
+    EXPECT_NO_THROW(transcode(in.fd(), EncodingType::Base16, {}));
+}
+
+TEST(FdTest, BadInput) {
+    TempFile in, out;
+    in.write("Zm9vY");
+    EXPECT_THROW(transcode(in.fd(), EncodingType::Base64,
+                           {{out.fd(), EncodingType::Base16}}),
+                 std::runtime_error);
+}
+
+TEST(FdTest, Lines) {
+    std::string data, expected;
+    for (size_t i = 0; i < 200000; ++i) {
+        const std::string record(i % 23, static_cast<char>(i));
+        data += encode_trivial<ToBase64>(record) + "\n";
+        expected += encode_trivial<ToBase16>(record) + "\n";
+    }
+
+    for (size_t threads = 1; threads <= 4; ++threads) {
+        TempFile in, out;
+        in.write(data);
+        transcodeLines(in.fd(), EncodingType::Base64, out.fd(),
+                       EncodingType::Base16, threads);
+        EXPECT_EQ(expected, out.contents());
+    }
+}
+
+TEST(FdTest, LinesBadRecord) {
+    TempFile in, out;
+    in.write("66\n6\n666F\n");
+    try {
+        transcodeLines(in.fd(), EncodingType::Base16, out.fd(),
+                       EncodingType::Binary, 2);
+        FAIL();
+    } catch (const std::runtime_error& e) {
+        EXPECT_EQ(0, std::string(e.what()).find("Line 2: "));
+    }
+}
+
+TEST(FdTest, Hashes) {
+    TempFile in, out;
+    in.write("sha256-47DEQpj8HBSa+/TImW+5JCeuQeRkm5NMpJWZG3hSuFU=\n"
+             "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    transcodeHashes(in.fd(), out.fd(), HashFormat::Nix32, true);
+    EXPECT_EQ("sha256:0mdqa9w1p6cmli6976v4wi0sw9r4p5prkj7lzfd1877wk11c9c73\n"
+              "sha256:0mdqa9w1p6cmli6976v4wi0sw9r4p5prkj7lzfd1877wk11c9c73\n",
+              out.contents());
+}
+
+TEST(FdTest, Range) {
+    const std::string data = testData(5000);
+    std::string encoded = encode_trivial<ToBase64>(data);
+    for (size_t i = 76; i < encoded.size(); i += 77)
+        encoded.insert(i, "\n");
+    const std::string expected = encode_trivial<ToBase32>(data);
+
+    TempFile in, whole;
+    in.write(encoded);
+    transcodeRange(in.fd(), EncodingType::Base64, whole.fd(),
+                   EncodingType::Base32);
+    EXPECT_EQ(expected, whole.contents());
+
+    // Each range carries on from the serialized checkpoint of the last
+    for (const size_t step : {1000, 1001, 3333, 7000}) {
+        TempFile out;
+        Checkpoint checkpoint;
+        for (uint64_t end = step; end < encoded.size(); end += step) {
+            checkpoint = Checkpoint::parse(
+                transcodeRange(in.fd(), EncodingType::Base64, out.fd(),
+                               EncodingType::Base32, checkpoint, end)
+                    .serialize());
+            EXPECT_EQ(end, checkpoint.offset);
+        }
+        transcodeRange(in.fd(), EncodingType::Base64, out.fd(),
+                       EncodingType::Base32, checkpoint);
+        EXPECT_EQ(expected, out.contents());
+    }
+}
+
+TEST(FdTest, Shards) {
+    const std::string data = testData(10000);
+    TempFile in, out;
+    in.write(data);
+
+    // Splittable shards are converted and completed independently
+    for (size_t i = 0; i < 7; ++i) {
+        const auto [begin, end] = shardRange(
+            data.size(), i, 7, EncodingType::Binary, EncodingType::Base32);
+        Checkpoint start;
+        start.offset = begin;
+        transcodeRange(in.fd(), EncodingType::Binary, out.fd(),
+                       EncodingType::Base32, start, end, true);
+    }
+    EXPECT_EQ(encode_trivial<ToBase32>(data), out.contents());
+}
+
+TEST(FdTest, DistinctFiles) {
+    const std::string missing = testing::TempDir() + "textencode-missing";
+    EXPECT_NO_THROW(checkDistinctFiles({"/dev/null", "/dev/zero", missing}));
+    EXPECT_THROW(checkDistinctFiles({missing, "/dev/null", missing}),
+                 std::invalid_argument);
+    // Another name for an existing file
+    EXPECT_THROW(checkDistinctFiles({"/dev/null", "/dev/./null"}),
+                 std::invalid_argument);
+}
+
+TEST(FdTest, BadCheckpoint) {
+    EXPECT_THROW(Checkpoint::parse(""), std::invalid_argument);
+    // State lengths running past the end
+    EXPECT_THROW(Checkpoint::parse(std::string("\x00\x01", 2)),
+                 std::invalid_argument);
+    EXPECT_THROW(Checkpoint::parse(std::string("\x00\x00\x02" "a", 4)),
+                 std::invalid_argument);
+    EXPECT_THROW(Checkpoint::parse("\x01\x05" "ab\x00"), std::invalid_argument);
+    EXPECT_THROW(Checkpoint::parse(std::string("\x01\0\0\0", 4)),
+                 std::invalid_argument);
+
+    TempFile in, out;
+    in.write("Zm9vYmFy");
+    Checkpoint checkpoint{4, "\x08", ""};
+    EXPECT_THROW(transcodeRange(in.fd(), EncodingType::Base64, out.fd(),
+                                EncodingType::Base32, checkpoint),
+                 std::invalid_argument);
+}
+
+}  // namespace textencode
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <textencode/hash.hpp>
+
+namespace textencode {
+
+// Digests of "abc"
+constexpr std::string_view sha256_hex =
+    "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad";
+constexpr std::string_view sha256_nix32 =
+    "1b8m03r63zqhnjf7l5wnldhh7c134ap5vpj0850ymkq1iyzicy5s";
+constexpr std::string_view sha256_base64 =
+    "ungWv48Bz+pBQUDeXa4iI7ADYaOWF3qctBD/YfIAFa0=";
+constexpr std::string_view sha512_nix32 =
+    "2gs8k559z4rlahfx0y688s49m2vvszylcikrfinm30ly9rak69236nkam5ydvly1ai7xac99"
+    "vxfc4ii84hawjbk876blyk1jfhkbbyx";
+constexpr std::string_view sha512_base64 =
+    "3a81oZNherrMQXNJriBBMRLm+k6JqX6iCp7u5ktV05ohkpkqJ0/BqDa6PCOj/uu9RU1EI2Q86A"
+    "4qmslPpUyknw==";
+
+TEST(HashTest, Sizes) {
+    EXPECT_EQ(32, digestSize(DigestType::Sha256));
+    EXPECT_EQ(64, digestSize(DigestType::Sha512));
+    EXPECT_EQ("sha256", digestName(DigestType::Sha256));
+    EXPECT_EQ("sha512", digestName(DigestType::Sha512));
+}
+
+TEST(HashTest, ParseForms) {
+    const std::string forms[] = {
+        std::string(sha256_hex),
+        std::string(sha256_nix32),
+        std::string(sha256_base64),
+        "sha256:" + std::string(sha256_hex),
+        "sha256:" + std::string(sha256_nix32),
+        "sha256:" + std::string(sha256_base64),
+        "sha256-" + std::string(sha256_base64),
+        "BA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD",
+    };
+    for (const auto& form : forms) {
+        const Hash hash = parseHash(form);
+        EXPECT_EQ(DigestType::Sha256, hash.type);
+        EXPECT_EQ(sha256_hex, formatHash(hash, HashFormat::Base16)) << form;
+    }
+}
+
+TEST(HashTest, ParseSha512) {
+    const Hash hash = parseHash("sha512-" + std::string(sha512_base64));
+    EXPECT_EQ(DigestType::Sha512, hash.type);
+    EXPECT_EQ(64, hash.bytes().size());
+    EXPECT_EQ(sha512_nix32, formatHash(hash, HashFormat::Nix32));
+    EXPECT_EQ(hash.bytes(), parseHash(sha512_nix32).bytes());
+}
+
+TEST(HashTest, Format) {
+    const Hash hash = parseHash(sha256_nix32);
+    EXPECT_EQ(sha256_nix32, formatHash(hash, HashFormat::Nix32));
+    EXPECT_EQ(sha256_base64, formatHash(hash, HashFormat::Base64));
+    EXPECT_EQ("sha256-" + std::string(sha256_base64),
+              formatHash(hash, HashFormat::Sri));
+    EXPECT_EQ("sha256:" + std::string(sha256_nix32),
+              formatHash(hash, HashFormat::Nix32, true));
+    EXPECT_EQ("sha256:" + std::string(sha256_hex),
+              formatHash(hash, HashFormat::Base16, true));
+}
+
+TEST(HashTest, Append) {
+    std::string out = "x ";
+    appendHash(out, parseHash(sha256_hex), HashFormat::Sri);
+    EXPECT_EQ("x sha256-" + std::string(sha256_base64), out);
+}
+
+TEST(HashTest, GivenType) {
+    EXPECT_EQ(DigestType::Sha256,
+              parseHash(sha256_hex, DigestType::Sha256).type);
+    EXPECT_THROW(parseHash(sha256_hex, DigestType::Sha512),
+                 std::runtime_error);
+    EXPECT_THROW(parseHash("sha256:" + std::string(sha256_hex),
+                           DigestType::Sha512),
+                 std::runtime_error);
+}
+
+TEST(HashTest, Invalid) {
+    EXPECT_THROW(parseHash(""), std::runtime_error);
+    EXPECT_THROW(parseHash("sha256:"), std::runtime_error);
+    EXPECT_THROW(parseHash("md5:" + std::string(sha256_hex)),
+                 std::runtime_error);
+    EXPECT_THROW(parseHash(sha256_hex.substr(1)), std::runtime_error);
+    // SRI digests are always base64
+    EXPECT_THROW(parseHash("sha256-" + std::string(sha256_hex)),
+                 std::runtime_error);
+    // Right length, but not a valid encoding
+    std::string bad(sha256_nix32);
+    bad[0] = 'e';
+    EXPECT_THROW(parseHash(bad), std::runtime_error);
+    bad = sha256_base64;
+    bad[42] = '=';
+    EXPECT_THROW(parseHash(bad), std::runtime_error);
+}
+
+TEST(HashTest, ConvertHashes) {
+    std::string out;
+    convertHashes("sha256:" + std::string(sha256_nix32) + "\n\n" +
+                      std::string(sha256_hex),
+                  HashFormat::Sri, out);
+    const std::string sri = "sha256-" + std::string(sha256_base64);
+    EXPECT_EQ(sri + "\n\n" + sri + "\n", out);
+}
+
+TEST(HashTest, ConvertCrlf) {
+    std::string out;
+    convertHashes(std::string(sha256_hex) + "\r\n\r\n" +
+                      std::string(sha256_base64) + "\r",
+                  HashFormat::Nix32, out, true);
+    const std::string nix32 = "sha256:" + std::string(sha256_nix32);
+    EXPECT_EQ(nix32 + "\n\n" + nix32 + "\n", out);
+}
+
+TEST(HashTest, ConvertBadHash) {
+    std::string out;
+    try {
+        convertHashes(std::string(sha256_hex) + "\nsha1:abc\n",
+                      HashFormat::Nix32, out, false, std::nullopt, 10);
+        FAIL();
+    } catch (const std::runtime_error& e) {
+        EXPECT_EQ(0, std::string(e.what()).find("Line 11: "));
+    }
+}
+
+}  // namespace textencode
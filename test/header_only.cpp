@@ -0,0 +1,34 @@
+// Linked with the library into one program, to check header-only converters
+// coexist with the library's own
+#define TEXTENCODE_HEADER_ONLY
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <textencode/base_n.hpp>
+#include <textencode/map.hpp>
+#include <textencode/nix.hpp>
+#include <typeinfo>
+
+namespace textencode {
+
+TEST(HeaderOnlyTest, MixedWithLibrary) {
+    const std::string data = "foobar";
+    for (const auto type : {EncodingType::Base64, EncodingType::Nix32}) {
+        const auto library = to_binary.at(type)();
+        std::unique_ptr<Converter> header_only;
+        if (type == EncodingType::Base64)
+            header_only = std::make_unique<ToBase64>();
+        else
+            header_only = std::make_unique<ToNix32>();
+        EXPECT_NE(typeid(*library), typeid(*header_only));
+
+        std::string expected = library->process(data);
+        expected += library->complete();
+        std::string actual = header_only->process(data);
+        actual += header_only->complete();
+        EXPECT_EQ(expected, actual);
+    }
+}
+
+}  // namespace textencode
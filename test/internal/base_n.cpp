@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <string>
 #include <textencode/internal/base_n.hpp>
 #include <textencode/internal/common.hpp>
 
@@ -89,4 +90,27 @@ TEST(InternalBaseNTest, Base64Common) {
     EXPECT_EQ(static_cast<int>(CharCodes::Padding), Common::inverse['=']);
 }
 
+TEST(InternalBaseNTest, EncodeQuanta) {
+    char out[16];
+    encodeQuanta<EncodingType::Base64>("foobar", 2, out);
+    EXPECT_EQ("Zm9vYmFy", std::string(out, 8));
+    encodeQuanta<EncodingType::Base32>("fooba", 1, out);
+    EXPECT_EQ("MZXW6YTB", std::string(out, 8));
+    encodeQuanta<EncodingType::Base16>("\x9f", 1, out);
+    EXPECT_EQ("9F", std::string(out, 2));
+}
+
+TEST(InternalBaseNTest, DecodeQuanta) {
+    char out[16];
+    EXPECT_EQ(2, decodeQuanta<EncodingType::Base64>("Zm9vYmFy", 2, out));
+    EXPECT_EQ("foobar", std::string(out, 6));
+    EXPECT_EQ(1, decodeQuanta<EncodingType::Base32>("mzxw6ytb", 1, out));
+    EXPECT_EQ("fooba", std::string(out, 5));
+
+    // Stops at the first quantum with anything but data
+    EXPECT_EQ(1, decodeQuanta<EncodingType::Base64>("Zm9vYg==", 2, out));
+    EXPECT_EQ(0, decodeQuanta<EncodingType::Base64>("Zm9\n", 1, out));
+    EXPECT_EQ(0, decodeQuanta<EncodingType::Base16>("\xff" "0", 1, out));
+}
+
 }  // namespace textencode::internal
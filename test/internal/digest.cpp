@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <textencode/digest.hpp>
+#include <textencode/internal/digest.hpp>
+
+namespace textencode::internal {
+
+// Pads a short message into the final block(s) by hand
+template <DigestType type>
+std::string pad(std::string data) {
+    using Common = Sha2Common<type>;
+    const uint64_t bits = data.size() * 8;
+    data += '\x80';
+    while ((data.size() + sizeof(typename Common::Word) * 2) %
+               Common::block_size !=
+           0)
+        data += '\0';
+    data.append(sizeof(typename Common::Word) * 2 - 8, '\0');
+    for (size_t i = 8; i > 0; --i)
+        data += static_cast<char>(bits >> ((i - 1) * 8));
+    return data;
+}
+
+TEST(InternalDigestTest, Sha256Common) {
+    using Common = Sha2Common<DigestType::Sha256>;
+    EXPECT_EQ(64, Common::block_size);
+    EXPECT_EQ(32, Common::digest_size);
+    EXPECT_EQ(64, Common::rounds.size());
+    EXPECT_EQ(0x80000000u, Common::rotr(1, 1));
+    EXPECT_EQ(0x01020304u, Common::load("\x01\x02\x03\x04"));
+}
+
+TEST(InternalDigestTest, Sha512Common) {
+    using Common = Sha2Common<DigestType::Sha512>;
+    EXPECT_EQ(128, Common::block_size);
+    EXPECT_EQ(64, Common::digest_size);
+    EXPECT_EQ(80, Common::rounds.size());
+    EXPECT_EQ(0x8000000000000000u, Common::rotr(1, 1));
+}
+
+TEST(InternalDigestTest, Sha256Compress) {
+    using Common = Sha2Common<DigestType::Sha256>;
+    auto state = Common::initial;
+    const std::string block = pad<DigestType::Sha256>("abc");
+    ASSERT_EQ(64, block.size());
+    Common::compress(state, block.data(), 1);
+    EXPECT_EQ(0xba7816bfu, state[0]);
+    EXPECT_EQ(0xf20015adu, state[7]);
+}
+
+TEST(InternalDigestTest, Sha256MatchesPortable) {
+    // The public converter may use an accelerated compression function
+    using Common = Sha2Common<DigestType::Sha256>;
+    std::string data;
+    for (size_t size = 0; size < 300; ++size) {
+        auto state = Common::initial;
+        const std::string padded = pad<DigestType::Sha256>(data);
+        Common::compress(state, padded.data(), padded.size() / 64);
+
+        std::string expected;
+        for (const uint32_t word : state)
+            for (size_t i = 4; i > 0; --i)
+                expected += static_cast<char>(word >> ((i - 1) * 8));
+
+        Sha256 d;
+        d.process(data);
+        EXPECT_EQ(expected, d.complete());
+        data += static_cast<char>(size * 7 + 3);
+    }
+}
+
+TEST(InternalDigestTest, Sha512Compress) {
+    using Common = Sha2Common<DigestType::Sha512>;
+    auto state = Common::initial;
+    const std::string block = pad<DigestType::Sha512>("abc");
+    ASSERT_EQ(128, block.size());
+    Common::compress(state, block.data(), 1);
+    EXPECT_EQ(0xddaf35a193617abau, state[0]);
+    EXPECT_EQ(0x454d4423643ce80eu, state[6]);
+}
+
+}  // namespace textencode::internal
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <textencode/internal/radix.hpp>
+
+namespace textencode::internal {
+
+namespace {
+
+constexpr uint64_t radix58 = 430804206899405824ull;
+
+template <uint64_t radix>
+Limbs pattern(size_t size, uint64_t seed) {
+    Limbs ret;
+    for (size_t i = 0; i < size; ++i) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        ret.push_back(radix == 0 ? seed : seed % radix);
+    }
+    trim(ret);
+    return ret;
+}
+
+template <uint64_t radix>
+void checkMultiply(size_t na, size_t nb) {
+    const Limbs a = pattern<radix>(na, na), b = pattern<radix>(nb, nb + 1);
+    EXPECT_EQ(schoolbookMultiply<radix>(a.data(), a.size(), b.data(), b.size()),
+              multiply<radix>(a.data(), a.size(), b.data(), b.size()))
+        << na << "x" << nb;
+}
+
+}  // namespace
+
+TEST(InternalRadixTest, MulAdd) {
+    Limbs a;
+    mulAdd<0>(a, 10, 0);
+    EXPECT_TRUE(a.empty());
+    mulAdd<0>(a, 10, 7);
+    EXPECT_EQ(Limbs{7}, a);
+    a = {UINT64_MAX};
+    mulAdd<0>(a, 2, 3);
+    EXPECT_EQ((Limbs{1, 2}), a);
+    a = {radix58 - 1};
+    mulAdd<radix58>(a, 1, 1);
+    EXPECT_EQ((Limbs{0, 1}), a);
+}
+
+TEST(InternalRadixTest, Karatsuba) {
+    for (const size_t size : {32, 33, 64, 100, 257}) {
+        checkMultiply<0>(size, size);
+        checkMultiply<radix58>(size, size);
+    }
+    // Unbalanced operands
+    checkMultiply<0>(40, 300);
+    checkMultiply<radix58>(500, 33);
+}
+
+TEST(InternalRadixTest, DivideAndConquer) {
+    const Limbs chunks = pattern<0>(1000, 3);
+    for (const size_t leaf : {1, 3, 32}) {
+        EXPECT_EQ(RadixConverter<radix58>(UINT64_MAX, 2000)
+                      .convert(chunks.data(), chunks.size()),
+                  RadixConverter<radix58>(UINT64_MAX, leaf)
+                      .convert(chunks.data(), chunks.size()))
+            << leaf;
+    }
+}
+
+TEST(InternalRadixTest, Convert) {
+    const uint64_t chunks[] = {1, 2};
+    EXPECT_TRUE(RadixConverter<0>(radix58).convert(chunks, 0).empty());
+    EXPECT_EQ(Limbs{radix58 + 2},
+              RadixConverter<0>(radix58).convert(chunks, 2));
+    EXPECT_EQ(Limbs{(uint64_t(1) << 56) + 2},
+              RadixConverter<radix58>(uint64_t(1) << 56).convert(chunks, 2));
+}
+
+}  // namespace textencode::internal
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <textencode/lines.hpp>
+
+namespace textencode {
+
+TEST(LinesTest, NoInput) {
+    std::string out;
+    convertLines("", EncodingType::Base16, EncodingType::Base64, out);
+    EXPECT_EQ("", out);
+}
+
+TEST(LinesTest, Records) {
+    std::string out;
+    convertLines("666F6F\n66\n\n666F6F626172\n", EncodingType::Base16,
+                 EncodingType::Nix32, out);
+    EXPECT_EQ("6yvv6\n36\n\n3jc5i6yvv6\n", out);
+}
+
+TEST(LinesTest, Unterminated) {
+    std::string out = "Zg==\n";
+    convertLines("fo\r\nfoo", EncodingType::Binary, EncodingType::Base64, out);
+    EXPECT_EQ("Zg==\nZm8N\nZm9v\n", out);
+}
+
+TEST(LinesTest, IndependentPadding) {
+    // Each record must be complete on its own
+    std::string out;
+    convertLines("Zg==\nZm8=\n", EncodingType::Base64, EncodingType::Binary,
+                 out);
+    EXPECT_EQ("f\nfo\n", out);
+}
+
+TEST(LinesTest, BadRecord) {
+    std::string out;
+    try {
+        convertLines("Zg==\nZm8\n", EncodingType::Base64, EncodingType::Binary,
+                     out, 10);
+        FAIL();
+    } catch (const std::runtime_error& e) {
+        EXPECT_EQ(0, std::string(e.what()).find("Line 11: "));
+    }
+}
+
+}  // namespace textencode
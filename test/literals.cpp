@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <textencode/base_n.hpp>
+#include <textencode/literals.hpp>
+#include <textencode/nix.hpp>
+
+#include "common.hpp"
+
+namespace textencode {
+
+namespace {
+
+template <size_t size>
+std::string str(const std::array<char, size>& data) {
+    return std::string(data.data(), data.size());
+}
+
+constexpr std::array<char, 7> input = {'f', 'o', 'o', 'b', 'a', 'r', '\xff'};
+
+template <EncodingType type, size_t size, typename Encoder>
+void roundTrip() {
+    std::array<char, size> data{};
+    for (size_t i = 0; i < size; ++i)
+        data[i] = input[i];
+
+    const auto encoded = encode<type>(data);
+    EXPECT_EQ(encode_trivial<Encoder>(str(data)), str(encoded));
+    EXPECT_EQ(size, decodedSize<type>(str(encoded)));
+    EXPECT_EQ(str(data), str(decode<type, size>(str(encoded))));
+}
+
+template <EncodingType type, typename Encoder>
+void roundTrips() {
+    roundTrip<type, 0, Encoder>();
+    roundTrip<type, 1, Encoder>();
+    roundTrip<type, 2, Encoder>();
+    roundTrip<type, 3, Encoder>();
+    roundTrip<type, 4, Encoder>();
+    roundTrip<type, 5, Encoder>();
+    roundTrip<type, 6, Encoder>();
+    roundTrip<type, 7, Encoder>();
+}
+
+}  // namespace
+
+TEST(LiteralsTest, RoundTrip) {
+    roundTrips<EncodingType::Base16, ToBase16>();
+    roundTrips<EncodingType::Base32, ToBase32>();
+    roundTrips<EncodingType::Nix32, ToNix32>();
+    roundTrips<EncodingType::Base64, ToBase64>();
+}
+
+TEST(LiteralsTest, ConstantEncode) {
+    constexpr auto encoded = encode<EncodingType::Base64>(
+        std::array<char, 4>{'f', 'o', 'o', 'b'});
+    static_assert(encoded[5] == 'g' && encoded[7] == '=');
+    EXPECT_EQ("Zm9vYg==", str(encoded));
+}
+
+TEST(LiteralsTest, Macro) {
+    constexpr auto hex = TEXTENCODE_DECODE(EncodingType::Base16, "666f6F");
+    static_assert(hex.size() == 3 && hex[2] == 'o');
+    EXPECT_EQ("foo", str(hex));
+
+    constexpr auto wrapped =
+        TEXTENCODE_DECODE(EncodingType::Base64, "Zm9v\nYmFy\n");
+    EXPECT_EQ("foobar", str(wrapped));
+
+    constexpr auto nix = TEXTENCODE_DECODE(EncodingType::Nix32, "3jc5i6yvv6");
+    EXPECT_EQ("foobar", str(nix));
+}
+
+TEST(LiteralsTest, Invalid) {
+    // Each of these would be a compile error in a constant expression
+    EXPECT_THROW((decode<EncodingType::Base16, 1>("6")), std::runtime_error);
+    EXPECT_THROW((decode<EncodingType::Base16, 1>("6g")), std::runtime_error);
+    EXPECT_THROW((decode<EncodingType::Base64, 1>("Zh==")),
+                 std::runtime_error);
+    EXPECT_THROW((decode<EncodingType::Base64, 1>("Zg=")), std::runtime_error);
+    EXPECT_THROW((decode<EncodingType::Base64, 2>("Zg==Zg==")),
+                 std::runtime_error);
+    EXPECT_THROW((decode<EncodingType::Base64, 1>("Z===")),
+                 std::runtime_error);
+    EXPECT_THROW((decode<EncodingType::Nix32, 0>("0")), std::runtime_error);
+    EXPECT_THROW((decode<EncodingType::Nix32, 1>("0e")), std::runtime_error);
+    EXPECT_THROW((decode<EncodingType::Nix32, 1>("z0")), std::runtime_error);
+    EXPECT_THROW((decode<EncodingType::Nix32, 2>("00")), std::runtime_error);
+}
+
+#if __cpp_nontype_template_args >= 201911L && __cpp_consteval >= 201811L
+
+TEST(LiteralsTest, Literals) {
+    using namespace literals;
+    constexpr auto hex = "666F6f626172"_hex;
+    static_assert(hex.size() == 6);
+    EXPECT_EQ("foobar", str(hex));
+    EXPECT_EQ("foobar", str("MZXW6YTBOI======"_b32));
+    EXPECT_EQ("foobar", str("3jc5i6yvv6"_nix32));
+    EXPECT_EQ("foobar", str("Zm9vYmFy"_b64));
+    EXPECT_EQ("", str(""_b64));
+}
+
+#endif
+
+}  // namespace textencode
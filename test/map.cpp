@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <textencode/map.hpp>
+#include <thread>
+#include <vector>
+
+#include "common.hpp"
+
+namespace textencode {
+
+TEST(MapTest, DecodeInPlace) {
+    std::string data = "Zm9vYmFy";
+    decodeInPlace(EncodingType::Base64, data);
+    EXPECT_EQ("foobar", data);
+
+    decodeInPlace(EncodingType::Binary, data);
+    EXPECT_EQ("foobar", data);
+
+    data = "3jc5i6yvv6";
+    decodeInPlace(EncodingType::Nix32, data);
+    EXPECT_EQ("foobar", data);
+
+    data = "666";
+    EXPECT_THROW(decodeInPlace(EncodingType::Base16, data),
+                 std::runtime_error);
+}
+
+TEST(MapTest, InPlaceMatchesConverters) {
+    for (const auto& [type, decode] : in_place_from_binary) {
+        auto encoder = to_binary.at(type)();
+        std::string data = encoder->process("\x01\x02\x03\xfe\xff");
+        data += encoder->complete();
+
+        auto decoder = from_binary.at(type)();
+        std::string expected = decoder->process(data);
+        expected += decoder->complete();
+
+        data.resize(decode(data.data(), data.size()));
+        EXPECT_EQ(expected, data);
+    }
+}
+
+TEST(MapTest, Reset) {
+    const std::string data = "\x01\x02\x03\xfe\xff\x00\x10";
+    for (const auto& [type, make_encoder] : to_binary) {
+        auto encoder = make_encoder();
+        std::string encoded = encoder->process(data);
+        encoded += encoder->complete();
+
+        encoder->process("\xff\xff");
+        encoder->reset();
+        std::string ret = encoder->process(data);
+        ret += encoder->complete();
+        EXPECT_EQ(encoded, ret);
+
+        auto decoder = from_binary.at(type)();
+        decoder->process(encoded.substr(0, 3));
+        decoder->reset();
+        ret = decoder->process(encoded);
+        ret += decoder->complete();
+        EXPECT_EQ(data, ret);
+    }
+
+    for (const auto& [type, make_digest] : digests) {
+        auto digest = make_digest();
+        digest->process(data);
+        const std::string expected = digest->complete();
+        digest->process(std::string(100, 'x'));
+        digest->reset();
+        digest->process(data);
+        EXPECT_EQ(expected, digest->complete());
+    }
+}
+
+TEST(MapTest, MemoryResource) {
+    const std::string data(1000, '\x5a');
+    for (const auto& [type, make_encoder] : to_binary) {
+        auto encoder = make_encoder();
+        std::string encoded = encoder->process(data);
+        encoded += encoder->complete();
+
+        CountingResource resource;
+        encoder = make_encoder();
+        std::pmr::string ret = encoder->process(data, &resource);
+        EXPECT_EQ(&resource, ret.get_allocator().resource());
+        ret += encoder->complete(&resource);
+        EXPECT_EQ(encoded, std::string_view(ret));
+        EXPECT_LT(0, resource.allocations);
+
+        auto decoder = from_binary.at(type)();
+        std::pmr::string decoded = decoder->process(encoded, &resource);
+        decoded += decoder->complete(&resource);
+        EXPECT_EQ(data, std::string_view(decoded));
+    }
+
+    for (const auto& [type, make_digest] : digests) {
+        auto digest = make_digest();
+        digest->process(data);
+        const std::string expected = digest->complete();
+        CountingResource resource;
+        digest = make_digest();
+        EXPECT_EQ("", digest->process(data, &resource));
+        EXPECT_EQ(expected, std::string_view(digest->complete(&resource)));
+    }
+}
+
+TEST(MapTest, Pool) {
+    clearPool();
+    Converter* first = nullptr;
+    {
+        auto encoder = acquire(to_binary, EncodingType::Base64);
+        first = encoder.get();
+        // Returned part way through
+        EXPECT_EQ("Zm9v", encoder->process("foob"));
+    }
+    {
+        auto encoder = acquire(to_binary, EncodingType::Base64);
+        EXPECT_EQ(first, encoder.get());
+        // In use, so a second one is made
+        auto other = acquire(to_binary, EncodingType::Base64);
+        EXPECT_NE(first, other.get());
+        EXPECT_EQ("", encoder->process("foo"));
+        EXPECT_EQ("Zm9v", encoder->complete());
+    }
+
+    // Spares are kept per map and type
+    auto decoder = acquire(from_binary, EncodingType::Base64);
+    EXPECT_NE(first, decoder.get());
+    auto base32 = acquire(to_binary, EncodingType::Base32);
+    EXPECT_NE(first, base32.get());
+}
+
+TEST(MapTest, PoolLimit) {
+    size_t made = 0;
+    const ConverterMap counted = {
+        {EncodingType::Base16, [&]() {
+             made += 1;
+             return to_binary.at(EncodingType::Base16)();
+         }},
+    };
+    for (size_t round = 0; round < 2; ++round) {
+        std::vector<PooledConverter> held;
+        for (size_t i = 0; i < max_spare_converters + 4; ++i)
+            held.push_back(acquire(counted, EncodingType::Base16));
+    }
+    // Only max_spare_converters came back to be reused
+    EXPECT_EQ(max_spare_converters + 8, made);
+    clearPool();
+}
+
+TEST(MapTest, PoolPerThread) {
+    clearPool();
+    Converter* mine = acquire(to_binary, EncodingType::Nix32).get();
+    std::thread([mine]() {
+        auto encoder = acquire(to_binary, EncodingType::Nix32);
+        EXPECT_NE(mine, encoder.get());
+        encoder->process("foobar");
+        EXPECT_EQ("3jc5i6yvv6", encoder->complete());
+    }).join();
+    EXPECT_EQ(mine, acquire(to_binary, EncodingType::Nix32).get());
+
+    clearPool();
+    auto encoder = acquire(to_binary, EncodingType::Nix32);
+    encoder->process("foobar");
+    EXPECT_EQ("3jc5i6yvv6", encoder->complete());
+}
+
+}  // namespace textencode
@@ -1,4 +1,7 @@
 #include <gtest/gtest.h>
+#include <memory_resource>
+#include <string>
+#include <string_view>
 #include <textencode/nix.hpp>
 
 #include "common.hpp"
@@ -47,6 +50,7 @@ TEST(Nix32Test, BadCharacters) {
     EXPECT_THROW(FromNix32().process("e"), std::runtime_error);
     EXPECT_THROW(FromNix32().process("E"), std::runtime_error);
     EXPECT_THROW(FromNix32().process("+"), std::runtime_error);
+    EXPECT_THROW(FromNix32().process("\xff\x80"), std::runtime_error);
 }
 
 TEST(Nix32Test, BadPaddingSuperfluous) {
@@ -74,4 +78,74 @@ TEST(Nix32Test, BadZeroEncoding) {
     EXPECT_THROW(encode_trivial<FromNix32>("nyvv6"), std::runtime_error);
 }
 
+TEST(Nix32Test, InPlace) {
+    const auto decode = [](std::string data) {
+        data.resize(FromNix32::decodeInPlace(data.data(), data.size()));
+        return data;
+    };
+    EXPECT_EQ("", decode(""));
+    EXPECT_EQ("f", decode("36"));
+    EXPECT_EQ("foobar", decode("3Jc5i6yVv6"));
+    EXPECT_EQ("foob\x89", decode("i5i6yvv6"));
+    EXPECT_EQ("foo", decode("6 y\n\rvv6"));
+    EXPECT_THROW(decode("000"), std::runtime_error);
+    EXPECT_THROW(decode("nyvv6"), std::runtime_error);
+    EXPECT_THROW(decode("0e"), std::runtime_error);
+
+    const std::string data = testData(1000);
+    EXPECT_EQ(data, decode(encode_trivial<ToNix32>(data)));
+}
+
+TEST(Nix32Test, Snapshot) {
+    for (size_t split = 0; split <= 6; ++split) {
+        EXPECT_EQ("3jc5i6yvv6", convert_resumed<ToNix32>("foobar", split));
+        EXPECT_EQ("foobar", convert_resumed<FromNix32>("3jc5i6yvv6", split));
+    }
+    EXPECT_THROW(FromNix32().restore("\x20"), std::invalid_argument);
+}
+
+TEST(Nix32Test, ResetFreesLargeBuffers) {
+    CountingResource resource;
+    ToNix32 to(&resource);
+    to.process(std::string(1000, 'f'));
+    to.reset();
+    const size_t allocations = resource.allocations;
+    to.process(std::string(1000, 'f'));
+    EXPECT_EQ(allocations, resource.allocations);
+
+    // Freed rather than kept once past a MiB
+    to.process(std::string(2 << 20, 'f'));
+    to.reset();
+    const size_t after_reset = resource.allocations;
+    to.process(std::string(1000, 'f'));
+    EXPECT_EQ(after_reset + 1, resource.allocations);
+}
+
+TEST(Nix32Test, MemoryResource) {
+    // The buffered input comes from the converter's resource
+    const std::string data(1000, 'f');
+    CountingResource resource;
+    ToNix32 to(&resource);
+    FromNix32 from(&resource);
+    to.process(data);
+    const std::string encoded = to.complete();
+    EXPECT_LE(data.size(), resource.bytes);
+    from.process(encoded);
+    EXPECT_LE(data.size() + encoded.size(), resource.bytes);
+    EXPECT_EQ(data, from.complete());
+
+    // and keeps its capacity across uses
+    const size_t allocations = resource.allocations;
+    to.process(data);
+    to.complete();
+    from.process(encoded);
+    from.complete();
+    EXPECT_EQ(allocations, resource.allocations);
+
+    // A result on the same resource takes over the buffer
+    from.process(encoded);
+    EXPECT_EQ(data, std::string_view(from.complete(&resource)));
+    EXPECT_EQ(allocations, resource.allocations);
+}
+
 }  // namespace textencode
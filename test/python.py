@@ -0,0 +1,79 @@
+import threading
+import unittest
+
+import textencode
+
+
+class TextencodeTest(unittest.TestCase):
+    def test_convert(self):
+        self.assertEqual(b"Zm9vYmFy", textencode.convert(b"foobar", "bin", "base64"))
+        self.assertEqual(b"666F6F", textencode.convert(b"Zm9v", "base64", "hex"))
+        self.assertEqual(b"foo", textencode.convert(memoryview(b"xfoox")[1:4], "bin", "bin"))
+
+    def test_errors(self):
+        with self.assertRaises(ValueError):
+            textencode.convert(b"Zm9", "base64", "bin")
+        with self.assertRaises(ValueError):
+            textencode.convert(b"", "base65", "bin")
+        with self.assertRaises(TypeError):
+            textencode.convert("text", "bin", "hex")
+
+    def test_streaming(self):
+        encoder = textencode.encoder("base32")
+        out = encoder.process(b"fo") + encoder.process(b"obar")
+        out += encoder.complete()
+        self.assertEqual(b"MZXW6YTBOI======", out)
+
+        decoder = textencode.decoder("nix32")
+        self.assertEqual(b"", decoder.process(b"6yvv6"))
+        self.assertEqual(b"foo", decoder.complete())
+
+    def test_convert_into(self):
+        out = bytearray(16)
+        self.assertEqual(8, textencode.convert_into(b"foobar", "bin", "base64", out))
+        self.assertEqual(b"Zm9vYmFy", out[:8])
+        with self.assertRaises(ValueError):
+            textencode.convert_into(b"foobar", "bin", "base64", bytearray(7))
+        with self.assertRaises(BufferError):
+            textencode.convert_into(b"foobar", "bin", "base64", b"readonly")
+
+    def test_convert_into_error(self):
+        out = bytearray(b"XXXXXXXXXXXX")
+        with self.assertRaises(ValueError):
+            textencode.convert_into(b"Zm9vYmFy!!!!", "base64", "bin", out)
+        self.assertEqual(b"XXXXXXXXXXXX", out)
+
+    def test_convert_in_place(self):
+        data = bytearray(b"Zm9vYmFy")
+        size = textencode.convert_into(data, "base64", "bin", data)
+        self.assertEqual(b"foobar", data[:size])
+
+    def test_no_constructor(self):
+        with self.assertRaises(TypeError):
+            textencode.Converter()
+
+    def test_batch(self):
+        items = [b"f", bytearray(b"fo"), memoryview(b"foo")]
+        self.assertEqual([b"66", b"666F", b"666F6F"],
+                         textencode.convert_batch(items, "bin", "hex"))
+        with self.assertRaises(ValueError):
+            textencode.convert_batch([b"Zg==", b"Zg"], "base64", "bin")
+
+    def test_threads(self):
+        data = bytes(range(256)) * 4096
+        expected = textencode.convert(data, "bin", "base64")
+        results = []
+
+        def work():
+            results.append(textencode.convert(data, "bin", "base64"))
+
+        threads = [threading.Thread(target=work) for _ in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        self.assertEqual([expected] * 4, results)
+
+
+if __name__ == "__main__":
+    unittest.main()
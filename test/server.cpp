@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <textencode/base_n.hpp>
+#include <textencode/server.hpp>
+#include <thread>
+#include <vector>
+
+#include "common.hpp"
+
+namespace textencode {
+
+class ServerTest : public testing::Test {
+  protected:
+    const std::string path = testing::TempDir() + "textencode-" +
+                             std::to_string(getpid()) + ".sock";
+    Server server{path};
+    std::thread thread{[this]() { server.run(); }};
+
+    ~ServerTest() override {
+        server.stop();
+        thread.join();
+    }
+
+    std::string remote(std::string_view data, EncodingType from,
+                       EncodingType to) {
+        TempFile in, out;
+        in.write(data);
+        transcodeRemote(path, in.fd(), from, out.fd(), to);
+        return out.contents();
+    }
+};
+
+TEST_F(ServerTest, Simple) {
+    EXPECT_EQ("3jc5i6yvv6",
+              remote("Zm9vYmFy", EncodingType::Base64, EncodingType::Nix32));
+    EXPECT_EQ("", remote("", EncodingType::Base16, EncodingType::Base64));
+}
+
+TEST_F(ServerTest, Large) {
+    // Larger than the server's output buffer, so backpressure kicks in
+    const std::string data = testData(3 << 20);
+    EXPECT_EQ(encode_trivial<ToBase64>(data),
+              remote(data, EncodingType::Binary, EncodingType::Base64));
+}
+
+TEST_F(ServerTest, Concurrent) {
+    std::vector<std::thread> clients;
+    std::vector<std::string> results(16);
+    for (size_t i = 0; i < results.size(); ++i)
+        clients.emplace_back([&, i]() {
+            results[i] = remote(std::string(i * 1000, 'f'),
+                                EncodingType::Binary, EncodingType::Base16);
+        });
+    for (auto& client : clients)
+        client.join();
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        std::string expected;
+        for (size_t j = 0; j < i * 1000; ++j)
+            expected += "66";
+        EXPECT_EQ(expected, results[i]);
+    }
+}
+
+TEST_F(ServerTest, BadInput) {
+    EXPECT_THROW(remote("Zm9vY", EncodingType::Base64, EncodingType::Binary),
+                 std::runtime_error);
+    // The server keeps serving other clients
+    EXPECT_EQ("foo", remote("Zm9v", EncodingType::Base64,
+                            EncodingType::Binary));
+}
+
+TEST_F(ServerTest, BufferedLimit) {
+    // Nix32 holds the whole request, so its total size is bounded
+    const std::string data((16 << 20) + 1, 'f');
+    EXPECT_THROW(remote(data, EncodingType::Binary, EncodingType::Nix32),
+                 std::runtime_error);
+    EXPECT_EQ(encode_trivial<ToBase16>(data),
+              remote(data, EncodingType::Binary, EncodingType::Base16));
+}
+
+TEST_F(ServerTest, Reuse) {
+    // Two requests over one connection, the second with a bad type
+    const int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, path.c_str());
+    ASSERT_EQ(0, connect(sock, reinterpret_cast<sockaddr*>(&addr),
+                         sizeof(addr)));
+
+    const std::string request("\x01\x04\x02\0\0\0\x36\x36\0\0\0\0\x01\x7f", 14);
+    ASSERT_EQ(request.size(), write(sock, request.data(), request.size()));
+
+    std::string response;
+    char buffer[256];
+    ssize_t ret;
+    while ((ret = read(sock, buffer, sizeof(buffer))) > 0)
+        response.append(buffer, ret);
+    close(sock);
+
+    EXPECT_EQ(std::string("\0\4\0\0\0Zg==\1\0\0\0\0\2", 15),
+              response.substr(0, 15));
+    EXPECT_EQ("Invalid encoding type", response.substr(19));
+}
+
+TEST(ServerPathTest, TooLong) {
+    EXPECT_THROW(Server(std::string(200, 'a')), std::runtime_error);
+}
+
+class ServerSocketTest : public testing::Test {
+  protected:
+    const std::string path = testing::TempDir() + "textencode-path-" +
+                             std::to_string(getpid()) + ".sock";
+
+    ~ServerSocketTest() override {
+        unlink(path.c_str());
+    }
+
+    bool exists() const {
+        struct stat st;
+        return lstat(path.c_str(), &st) == 0;
+    }
+};
+
+TEST_F(ServerSocketTest, RefusesOtherFiles) {
+    std::ofstream(path) << "data";
+    EXPECT_THROW(Server{path}, std::runtime_error);
+    EXPECT_TRUE(exists());
+
+    unlink(path.c_str());
+    ASSERT_EQ(0, symlink("/dev/null", path.c_str()));
+    EXPECT_THROW(Server{path}, std::runtime_error);
+    EXPECT_TRUE(exists());
+}
+
+TEST_F(ServerSocketTest, RefusesLiveSocket) {
+    Server server(path);
+    EXPECT_THROW(Server{path}, std::runtime_error);
+    EXPECT_TRUE(exists());
+}
+
+TEST_F(ServerSocketTest, ReplacesStaleSocket) {
+    // Bound but no longer listening, as left by a server that crashed
+    const int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, path.c_str());
+    ASSERT_EQ(0, bind(sock, reinterpret_cast<sockaddr*>(&addr),
+                      sizeof(addr)));
+    close(sock);
+
+    { Server server(path); }
+    EXPECT_FALSE(exists());
+}
+
+TEST_F(ServerSocketTest, KeepsReplacedPath) {
+    {
+        Server server(path);
+        unlink(path.c_str());
+        std::ofstream(path) << "data";
+    }
+    EXPECT_TRUE(exists());
+}
+
+}  // namespace textencode
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <textencode/base_n.hpp>
+#include <textencode/map.hpp>
+#include <textencode/stream.hpp>
+
+#include "common.hpp"
+
+namespace textencode {
+
+namespace {
+
+std::string encodeStream(EncodingType type, const std::string& data,
+                         size_t buffer_size) {
+    std::ostringstream sink;
+    {
+        EncodingStreambuf buf(to_binary.at(type)(), sink.rdbuf(), buffer_size);
+        std::ostream out(&buf);
+        for (size_t i = 0; i < data.size(); i += 3)
+            out << data.substr(i, 3);
+    }
+    return sink.str();
+}
+
+std::string decodeStream(EncodingType type, const std::string& data,
+                         size_t buffer_size) {
+    std::istringstream source(data);
+    DecodingStreambuf buf(from_binary.at(type)(), source.rdbuf(), buffer_size);
+    std::istream in(&buf);
+    std::string ret;
+    for (char c; in.get(c);)
+        ret += c;
+    return ret;
+}
+
+const std::string input = "Many hands make light work, some more than others.";
+
+}  // namespace
+
+TEST(StreamTest, Encode) {
+    for (size_t buffer_size : {1, 4, 7, 1 << 16})
+        EXPECT_EQ(encode_trivial<ToBase64>(input),
+                  encodeStream(EncodingType::Base64, input, buffer_size));
+}
+
+TEST(StreamTest, EncodeEmpty) {
+    EXPECT_EQ("", encodeStream(EncodingType::Base32, "", 16));
+}
+
+TEST(StreamTest, ZeroBufferSize) {
+    std::stringstream stream;
+    EXPECT_THROW(EncodingStreambuf(to_binary.at(EncodingType::Base64)(),
+                                   stream.rdbuf(), 0),
+                 std::invalid_argument);
+    EXPECT_THROW(DecodingStreambuf(from_binary.at(EncodingType::Base64)(),
+                                   stream.rdbuf(), 0),
+                 std::invalid_argument);
+}
+
+TEST(StreamTest, LargeWrite) {
+    const std::string data(1000, 'x');
+    std::ostringstream sink;
+    EncodingStreambuf buf(to_binary.at(EncodingType::Base16)(), sink.rdbuf(),
+                          16);
+    std::ostream out(&buf);
+    out << "ab";
+    out.write(data.data(), data.size());
+    buf.close();
+    EXPECT_EQ(encode_trivial<ToBase16>("ab" + data), sink.str());
+}
+
+TEST(StreamTest, SyncDoesNotComplete) {
+    std::ostringstream sink;
+    EncodingStreambuf buf(to_binary.at(EncodingType::Base64)(), sink.rdbuf());
+    std::ostream out(&buf);
+    out << "fo" << std::flush;
+    EXPECT_EQ("", sink.str());
+    out << "ob" << std::flush;
+    EXPECT_EQ("Zm9v", sink.str());
+    buf.close();
+    EXPECT_EQ("Zm9vYg==", sink.str());
+
+    // Nothing more can be written once closed
+    EXPECT_FALSE(out << "x" << std::flush);
+    EXPECT_EQ("Zm9vYg==", sink.str());
+}
+
+TEST(StreamTest, Decode) {
+    const std::string encoded = encode_trivial<ToBase64>(input);
+    for (size_t buffer_size : {1, 4, 7, 1 << 16})
+        EXPECT_EQ(input,
+                  decodeStream(EncodingType::Base64, encoded, buffer_size));
+}
+
+TEST(StreamTest, DecodeToEncoded) {
+    // Any converter can sit on the reading side
+    std::istringstream source("foob");
+    DecodingStreambuf buf(to_binary.at(EncodingType::Base64)(), source.rdbuf(),
+                          3);
+    std::istream in(&buf);
+    std::string ret;
+    std::getline(in, ret);
+    EXPECT_EQ("Zm9vYg==", ret);
+}
+
+TEST(StreamTest, DecodeError) {
+    std::istringstream source("Zm9=Yg==");
+    DecodingStreambuf buf(from_binary.at(EncodingType::Base64)(),
+                          source.rdbuf());
+    std::istream in(&buf);
+    in.exceptions(std::ios::badbit);
+    std::string ret;
+    EXPECT_THROW(std::getline(in, ret), std::runtime_error);
+}
+
+}  // namespace textencode
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <textencode/base_n.hpp>
+#include <textencode/view.hpp>
+
+#include "common.hpp"
+
+namespace textencode {
+
+std::string wrap(std::string_view data, size_t width) {
+    std::string ret;
+    for (size_t i = 0; i < data.size(); i += width)
+        ret += std::string(data.substr(i, width)) + "\r\n";
+    return ret;
+}
+
+template <typename Encoder, typename View>
+void testRanges(size_t index_stride) {
+    for (const size_t size : {0, 1, 2, 3, 4, 5, 6, 7, 100, 1001}) {
+        const std::string data = testData(size);
+        const std::string encoded = encode_trivial<Encoder>(data);
+        const std::string wrapped = wrap(encoded, 7) + " ";
+        const View view = index_stride == 0 ? View(encoded)
+                                            : View(wrapped, index_stride);
+        ASSERT_EQ(size, view.size());
+        for (size_t offset = 0; offset <= size; offset += 1 + offset / 5)
+            for (size_t len = 0; offset + len <= size; len += 1 + len / 3)
+                ASSERT_EQ(data.substr(offset, len), view.read(offset, len));
+    }
+}
+
+TEST(DecodedViewTest, Ranges) {
+    testRanges<ToBase16, DecodedView16>(0);
+    testRanges<ToBase32, DecodedView32>(0);
+    testRanges<ToBase64, DecodedView64>(0);
+}
+
+TEST(DecodedViewTest, WrappedRanges) {
+    for (const size_t stride : {1, 3, 64}) {
+        testRanges<ToBase16, DecodedView16>(stride);
+        testRanges<ToBase32, DecodedView32>(stride);
+        testRanges<ToBase64, DecodedView64>(stride);
+    }
+}
+
+TEST(DecodedViewTest, Iterator) {
+    const std::string data = testData(1000);
+    const std::string encoded = encode_trivial<ToBase32>(data);
+    const DecodedView32 view(encoded);
+
+    EXPECT_EQ(1000, view.end() - view.begin());
+    EXPECT_TRUE(std::equal(view.begin(), view.end(), data.begin()));
+    EXPECT_EQ(data, std::string(view.begin(), view.end()));
+    EXPECT_EQ(data[999], *(view.end() - 1));
+    EXPECT_EQ(data[512], view.begin()[512]);
+    EXPECT_EQ(data[17], view[17]);
+
+    auto it = view.begin() + 10;
+    EXPECT_EQ(data[10], *it--);
+    EXPECT_EQ(data[9], *it);
+    EXPECT_LT(it, view.end());
+}
+
+TEST(DecodedViewTest, Padding) {
+    const DecodedView64 view("Zm9vYg==\n");
+    EXPECT_EQ(4, view.size());
+    EXPECT_EQ("foob", view.read(0, 4));
+    EXPECT_EQ("ob", view.read(2, 2));
+
+    EXPECT_EQ("foo", DecodedView32("MZ XW\n6===", 2).read(0, 3));
+}
+
+TEST(DecodedViewTest, BadInput) {
+    EXPECT_THROW(DecodedView64("Zm9vY"), std::runtime_error);
+    EXPECT_THROW(DecodedView64("Zm9v===="), std::runtime_error);
+    EXPECT_THROW(DecodedView64("Zm=vYg==", 4), std::runtime_error);
+    EXPECT_THROW(DecodedView64("Zm9vYg==", 0), std::invalid_argument);
+
+    // Only the quanta that are read get validated
+    const DecodedView64 view("Zm9v-mFyZo==");
+    EXPECT_EQ("foo", view.read(0, 3));
+    EXPECT_THROW(view.read(3, 1), std::runtime_error);
+    EXPECT_THROW(view.read(6, 1), std::runtime_error);
+
+    // Whitespace needs an index
+    EXPECT_THROW(DecodedView64("Zm9v\nYmFy").read(3, 1), std::runtime_error);
+}
+
+TEST(DecodedViewTest, OutOfRange) {
+    const DecodedView16 view("666F6F");
+    EXPECT_EQ("", view.read(3, 0));
+    EXPECT_THROW(view.read(2, 2), std::out_of_range);
+    EXPECT_THROW(view.read(4, 0), std::out_of_range);
+    EXPECT_THROW(view[3], std::out_of_range);
+}
+
+}  // namespace textencode
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <list>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <textencode/base_n.hpp>
+#include <textencode/views.hpp>
+#include <vector>
+
+#include "common.hpp"
+
+namespace textencode {
+
+template <typename R>
+std::string collect(R&& range) {
+    std::string ret;
+    std::ranges::copy(range, std::back_inserter(ret));
+    return ret;
+}
+
+template <typename Encoder, EncodingType type>
+void testEncode() {
+    for (size_t size = 0; size < 300; size += 1 + size / 8) {
+        const std::string data = testData(size);
+        const std::string expected = encode_trivial<Encoder>(data);
+        const std::list<char> chained(data.begin(), data.end());
+
+        EXPECT_EQ(expected, collect(data | views::encode<type>));
+        EXPECT_EQ(expected, collect(chained | views::encode<type>));
+        EXPECT_EQ(expected, collect(std::string_view(data) |
+                                    std::views::filter([](char) {
+                                        return true;
+                                    }) |
+                                    views::encode<type>));
+    }
+}
+
+template <typename Decoder, EncodingType type>
+void testDecode(std::string_view encoded) {
+    const std::string expected = encode_trivial<Decoder>(encoded);
+    const std::list<char> chained(encoded.begin(), encoded.end());
+    EXPECT_EQ(expected, collect(encoded | views::decode<type>));
+    EXPECT_EQ(expected, collect(chained | views::decode<type>));
+}
+
+TEST(ViewsTest, Encode) {
+    testEncode<ToBase16, EncodingType::Base16>();
+    testEncode<ToBase32, EncodingType::Base32>();
+    testEncode<ToBase64, EncodingType::Base64>();
+}
+
+TEST(ViewsTest, Decode) {
+    for (size_t size = 0; size < 300; size += 1 + size / 8) {
+        const std::string data = testData(size);
+        testDecode<FromBase16, EncodingType::Base16>(
+            encode_trivial<ToBase16>(data));
+        testDecode<FromBase32, EncodingType::Base32>(
+            encode_trivial<ToBase32>(data));
+        testDecode<FromBase64, EncodingType::Base64>(
+            encode_trivial<ToBase64>(data));
+    }
+
+    testDecode<FromBase32, EncodingType::Base32>("Mz\nX W6 \r= ==\n");
+    testDecode<FromBase64, EncodingType::Base64>("Zm\n9vY g\r= =\n");
+    testDecode<FromBase64, EncodingType::Base64>("Zm9vYmFy\nZm9vYmFy\n");
+}
+
+TEST(ViewsTest, Compose) {
+    const std::string data = testData(1000);
+    EXPECT_EQ(data, collect(data | views::encode<EncodingType::Base64> |
+                            views::decode<EncodingType::Base64>));
+    EXPECT_EQ(encode_trivial<ToBase32>(data),
+              collect(data | views::encode<EncodingType::Base16> |
+                      views::decode<EncodingType::Base16> |
+                      views::encode<EncodingType::Base32>));
+    EXPECT_EQ("Zm9v", collect(std::string_view("foobar") | std::views::take(3) |
+                              views::encode<EncodingType::Base64>));
+}
+
+TEST(ViewsTest, BadInput) {
+    const auto decode64 = [](std::string_view data) {
+        return collect(data | views::decode<EncodingType::Base64>);
+    };
+    EXPECT_THROW(decode64("Zm9vY"), std::runtime_error);
+    EXPECT_THROW(decode64("Zm9v-mFy"), std::runtime_error);
+    EXPECT_THROW(decode64("Zg==Zm9v"), std::runtime_error);
+    EXPECT_THROW(decode64("Zm9v===="), std::runtime_error);
+    EXPECT_THROW(decode64("Zh=="), std::runtime_error);
+    EXPECT_THROW(collect(std::string_view("MZXW7===") |
+                         views::decode<EncodingType::Base32>),
+                 std::runtime_error);
+
+    // Data before the bad quantum is still produced
+    std::string out;
+    EXPECT_THROW(std::ranges::copy(std::string_view("Zm9vYmFy!") |
+                                       views::decode<EncodingType::Base64>,
+                                   std::back_inserter(out)),
+                 std::runtime_error);
+    EXPECT_EQ("foobar", out);
+}
+
+}  // namespace textencode